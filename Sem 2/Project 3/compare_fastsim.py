@@ -0,0 +1,57 @@
+"""Compare the ring profiles of the full and GFlash runs of fastsim.mac
+(full_scan.csv and fast_scan.csv), and print the speedup from its printout.
+
+    python3 compare_fastsim.py fastsim.log
+
+Writes fastsim.png: the mean energy in each ring for every beam energy, and
+the ratio of the fast to the full simulation.
+"""
+import re
+import sys
+
+import matplotlib
+matplotlib.use("Agg")
+import matplotlib.pyplot as plt
+import pandas as pd
+
+
+def ring_means(scan):
+    return scan[[c for c in scan.columns if c.startswith("Mean")]].to_numpy()
+
+
+def main():
+    full = pd.read_csv("full_scan.csv")
+    fast = pd.read_csv("fast_scan.csv")
+    rings = range(1, len(ring_means(full)[0]) + 1)
+
+    fig, (profile, ratio) = plt.subplots(2, 1, sharex=True, figsize=(8, 8))
+    for (_, row), full_mean, fast_mean in zip(full.iterrows(), ring_means(full), ring_means(fast)):
+        line, = profile.plot(rings, full_mean, label="{} MeV".format(row["Generated"]))
+        profile.plot(rings, fast_mean, "--", color=line.get_color())
+        ratio.plot(rings, fast_mean / full_mean, color=line.get_color())
+        print("{:6.0f} MeV: total {:8.2f} MeV full, {:8.2f} MeV fast".format(
+            row["Generated"], full_mean.sum(), fast_mean.sum()))
+    profile.set_yscale("log")
+    profile.set_ylabel("Mean energy per event [MeV] (full solid, fast dashed)")
+    profile.legend()
+    ratio.axhline(1.0, color="black", linewidth=0.5)
+    ratio.set_ylim(0.0, 2.0)
+    ratio.set_xlabel("Ring")
+    ratio.set_ylabel("Fast / full")
+    fig.savefig("fastsim.png")
+
+    # "RunAction: N events in T s, R events per second" ends the master's
+    # printout of each run, the worker lines go on with steps per event
+    if len(sys.argv) > 1:
+        with open(sys.argv[1]) as log:
+            text = log.read()
+        pattern = r"RunAction: \d+ events in \S+ s, (\S+) events per second"
+        rates = re.findall(pattern + "$", text, re.MULTILINE) or re.findall(pattern, text)
+        rates = [float(r) for r in rates]
+        if len(rates) >= 2:
+            # The last two runs are the full and the fast one, whatever ran before
+            print("Speedup: {:.1f} ({:.0f} events per second full, {:.0f} fast)".format(
+                rates[-1] / rates[-2], rates[-2], rates[-1]))
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,52 @@
+"""Compare the ring columns of the same events run through the replica and
+the placement layouts of the rings, written by bench.mac.
+
+    python3 compare_layouts.py output_replica.csv output_placement.csv
+
+The geometry is the same, so every event should leave the same energy in
+each ring. Prints how many events match exactly, and for each ring the mean
+energy of both layouts and the mean of their event by event difference in
+standard errors. Exits with status 1 if the files hold different events, or
+a ring is more than 4 standard errors off (tiny rounding differences in the
+navigation can change a shower from there on, so single events need not
+match to the last bit, and with a hundred rings 3 would fail by chance).
+"""
+import sys
+
+import numpy as np
+import pandas as pd
+
+
+def read_table(file_name):
+    # The column names are in the "#column <type> <name>" lines
+    with open(file_name) as f:
+        names = [line.split(None, 2)[2].strip() for line in f if line.startswith("#column")]
+    return pd.read_csv(file_name, comment="#", names=names).set_index("EventNumber").sort_index()
+
+
+def main():
+    replica = read_table(sys.argv[1])
+    placement = read_table(sys.argv[2])
+    if not replica.index.equals(placement.index) or not replica["Generated"].equals(placement["Generated"]):
+        print("The two files do not hold the same events")
+        return 1
+
+    rings = [c for c in replica.columns if c.startswith("Detector")]
+    same = (replica[rings] == placement[rings]).all(axis=1)
+    print("{} of {} events identical in every ring".format(same.sum(), len(same)))
+
+    worst = 0.0
+    for ring in rings:
+        a, b = replica[ring], placement[ring]
+        difference = a - b
+        error = difference.std() / np.sqrt(len(difference))
+        pull = abs(difference.mean()) / error if error > 0 else 0.0
+        worst = max(worst, pull)
+        print("{:>10}: {:10.4f} MeV replica, {:10.4f} MeV placement, {:5.2f} errors apart".format(
+            ring, a.mean(), b.mean(), pull))
+    print("Largest difference: {:.2f} standard errors".format(worst))
+    return 1 if worst > 4.0 else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -3,14 +3,21 @@
 
 #include "G4VUserActionInitialization.hh"
 
+class ScanGrid;
+
 // This class is a very simple template that just tells Geant where to look for our custom code
 class ActionInitialization : public G4VUserActionInitialization
 {
   public:
-    ActionInitialization();
+    ActionInitialization( const ScanGrid* scanGrid );
     ~ActionInitialization() override;
 
+    void BuildForMaster() const override;
     void Build() const override;
+
+  private:
+    // Shared by the generators and run actions of all threads
+    const ScanGrid* m_scanGrid;
 };
 
 #endif
@@ -0,0 +1,60 @@
+#ifndef ColumnWriter_h
+#define ColumnWriter_h 1
+
+#include "globals.hh"
+
+#include <fstream>
+#include <vector>
+
+// Native binary table of double columns, written a chunk of rows at a time
+// with each column of a chunk stored contiguously and, optionally, compressed
+// with zlib. Much smaller and faster to read back than CSV (see read_columns.py)
+//
+// File layout, in the byte order of the machine that wrote it:
+//   "P3COLS01"
+//   uint32 number of columns, then for each column: uint32 length, name
+//   chunks until the end of the file, each:
+//     uint32 number of rows, uint32 compression level (0 = raw doubles)
+//     for each column: uint64 stored size in bytes, the stored bytes
+// Chunks are independent, so files with the same columns could join by
+// appending the chunks of one to the other; Merge sorts the rows instead
+class ColumnWriter
+{
+  public:
+    ColumnWriter();
+    ~ColumnWriter();
+
+    // Columns must all be added before the file is opened
+    void AddColumn( const G4String& name );
+    G4int GetNumberOfColumns() const { return m_names.size(); }
+
+    G4bool Open( const G4String& fileName, G4int compressionLevel, G4int chunkRows );
+    void Fill( G4int column, G4double value );
+    void Fill( G4int firstColumn, const G4double* values, std::size_t n );
+    void AddRow();
+    void Close();
+
+    // Join the rows of several files into one, sorted by the first column and
+    // written again in chunks, deleting the inputs once it is written; false,
+    // with the inputs kept, if any of them does not match or cannot be read
+    // The whole table is held in memory while it is sorted
+    static G4bool Merge( const std::vector< G4String >& inputNames, const G4String& outputName,
+                         G4int compressionLevel, G4int chunkRows );
+
+  private:
+    void WriteHeader();
+    void WriteChunk();
+
+    std::vector< G4String > m_names;
+    // Values of the row being filled, and the rows of the chunk being built
+    std::vector< G4double > m_row;
+    std::vector< std::vector< G4double > > m_columns;
+    std::size_t m_nRows = 0;
+
+    std::ofstream m_file;
+    G4int m_compressionLevel = 0;
+    std::size_t m_chunkRows = 1;
+    std::vector< unsigned char > m_buffer;
+};
+
+#endif
@@ -5,7 +5,15 @@
 #include "G4SystemOfUnits.hh"
 #include "tls.hh"
 
-static const G4double radius = 100*cm;
-static const G4double detectorRingWidth = 1.0*cm;
+// Defaults of the geometry, which can be changed between runs with
+// /det/radius, /det/ringWidth and /det/absorberThickness
+static constexpr G4double defaultRadius = 100*cm;
+static constexpr G4double defaultRingWidth = 1.0*cm;
+static constexpr G4double defaultAbsorberThickness = 2.0*mm;
+
+// Fixed sizes (half lengths): the world cube, and the silicon along the beam,
+// with the absorber in front of it
+static constexpr G4double worldHalfLength = 250.0*cm;
+static constexpr G4double detectorHalfThickness = 5.0*cm;
 
 #endif
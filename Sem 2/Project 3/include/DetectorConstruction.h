@@ -2,7 +2,15 @@
 #define DetectorConstruction_h 1
 
 #include "G4VUserDetectorConstruction.hh"
-#include "G4GlobalMagFieldMessenger.hh"
+#include "Consts.h"
+
+#include <vector>
+
+class G4LogicalVolume;
+class G4UserLimits;
+class DetectorMessenger;
+class FieldControl;
+class FastShower;
 
 // Define the experiment to be simulated
 class DetectorConstruction : public G4VUserDetectorConstruction
@@ -13,11 +21,57 @@ class DetectorConstruction : public G4VUserDetectorConstruction
 
     G4VPhysicalVolume* Construct() override;
     void ConstructSDandField() override;
-    
+
+    // Regions with their own production cuts and step limits
+    // - Detector: the silicon rings, fine cuts
+    // - Absorber: the lead, coarse cuts
+    // - World: everything else, the coarse default cut (1 m from main(), changed with /run/setCut)
+    static G4String GetRegionNames() { return "Detector Absorber World"; }
+    // Step limits of a region, used by DetectorMessenger, 0 for an unknown name
+    G4UserLimits* GetUserLimits( const G4String& regionName );
+
+    // How the rings are built
+    // - replica: one cylinder, divided into rings with a G4PVReplica
+    // - placement: one volume per ring, placed in the world
+    // - disk: one volume, the rings are found from the radius of each step
+    void SetRingLayout( const G4String& layout ) { m_ringLayout = layout; }
+
+    // Sizes and the absorber material, used by DetectorMessenger, which
+    // rebuilds the geometry if a run has been initialised
+    // The detector is as many rings of ringWidth as fit in the radius
+    // False, with nothing changed, for a size that does not fit in the world
+    // or a ring wider than the radius
+    G4bool SetRadius( G4double radius );
+    G4bool SetRingWidth( G4double width );
+    G4bool SetAbsorberThickness( G4double thickness );
+    // False for a name the NIST manager does not know
+    G4bool SetAbsorberMaterial( const G4String& name );
+    G4int GetNumberOfRings() const;
+
+    // GFlash showers in the rings instead of full simulation, off by default,
+    // applied to the model of each thread when the geometry is next built
+    void SetFastShowers( G4bool fastShowers ) { m_fastShowers = fastShowers; }
+
   private:
-    // Global magnetic field messenger
-    static G4ThreadLocal G4GlobalMagFieldMessenger* m_magneticFieldMessenger;
-    int layerNum;
+    // No limits until set with the /det/ commands
+    G4UserLimits* m_detectorLimits;
+    G4UserLimits* m_absorberLimits;
+    G4UserLimits* m_worldLimits;
+    DetectorMessenger* m_messenger;
+
+    // Set with /det/ringLayout, and the volumes it made, for the sensitive detector
+    G4String m_ringLayout = "replica";
+    G4double m_radius = defaultRadius;
+    G4double m_ringWidth = defaultRingWidth;
+    G4double m_absorberThickness = defaultAbsorberThickness;
+    G4String m_absorberMaterial = "G4_Pb";
+    G4bool m_fastShowers = false;
+    std::vector< G4LogicalVolume* > m_ringLVs;
+
+    // Magnetic field of each thread
+    static G4ThreadLocal FieldControl* m_fieldControl;
+    // Parameterised showers in the rings, for each thread
+    static G4ThreadLocal FastShower* m_fastShower;
 };
 
 #endif
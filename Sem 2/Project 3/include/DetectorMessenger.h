@@ -0,0 +1,45 @@
+#ifndef DetectorMessenger_h
+#define DetectorMessenger_h 1
+
+#include "G4UImessenger.hh"
+
+class DetectorConstruction;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAString;
+class G4UIcmdWithABool;
+class G4UIcmdWithADoubleAndUnit;
+
+// The /det/ commands, setting the layout, sizes and absorber material, the
+// GFlash showers, and the step limits of each detector region
+// The geometry is shared by all threads, so these run on the master only, and
+// after /run/initialize a change rebuilds it for the next run
+class DetectorMessenger : public G4UImessenger
+{
+  public:
+    DetectorMessenger( DetectorConstruction* detector );
+    ~DetectorMessenger() override;
+
+    void SetNewValue( G4UIcommand* command, G4String newValue ) override;
+
+  private:
+    G4UIcommand* MakeLimitCommand( const G4String& name, const G4String& guidance,
+                                   const G4String& unitCategory, const G4String& defaultUnit );
+    G4UIcmdWithADoubleAndUnit* MakeSizeCommand( const G4String& name, const G4String& guidance, G4double defaultValue );
+    void ReinitializeGeometry();
+
+    DetectorConstruction* m_detector;
+
+    G4UIdirectory* m_directory;
+    G4UIcommand* m_maxStepCmd;
+    G4UIcommand* m_maxTrackLengthCmd;
+    G4UIcommand* m_minKineticEnergyCmd;
+    G4UIcmdWithAString* m_ringLayoutCmd;
+    G4UIcmdWithADoubleAndUnit* m_radiusCmd;
+    G4UIcmdWithADoubleAndUnit* m_ringWidthCmd;
+    G4UIcmdWithADoubleAndUnit* m_absorberThicknessCmd;
+    G4UIcmdWithAString* m_materialCmd;
+    G4UIcmdWithABool* m_fastShowersCmd;
+};
+
+#endif
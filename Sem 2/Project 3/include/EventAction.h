@@ -3,15 +3,24 @@
 
 #include "G4UserEventAction.hh"
 
+class RunAction;
+class GeneratorAction;
+class RingCalorimeterSD;
+
 // Something that happens once per event
 class EventAction : public G4UserEventAction
 {
   public:
-    EventAction();
+    EventAction( RunAction* runAction, GeneratorAction* generatorAction );
     ~EventAction() override;
 
     void BeginOfEventAction( const G4Event* ) override;
     void EndOfEventAction( const G4Event* ) override;
+
+  private:
+    RunAction* m_runAction;
+    GeneratorAction* m_generatorAction;
+    RingCalorimeterSD* m_calorimeter = nullptr;
 };
 
 #endif
@@ -0,0 +1,38 @@
+#ifndef FastShower_h
+#define FastShower_h 1
+
+#include "globals.hh"
+
+class G4Region;
+class G4Material;
+class GFlashShowerModel;
+class GFlashHomoShowerParameterisation;
+class GFlashParticleBounds;
+class GFlashHitMaker;
+
+// GFlash parameterised electromagnetic showers in one region, made per thread
+// in ConstructSDandField
+// The model is switched on and off with /det/fastShowers (off by default);
+// the /GFlash/ commands set its energy range (Emin, Emax, Ekill) and whether
+// the shower must be contained in the region (containment)
+// The energy spots go to sensitive detectors that are also
+// G4VGFlashSensitiveDetectors, i.e. the RingCalorimeterSD
+class FastShower
+{
+  public:
+    // The longitudinal and lateral profiles are those of a homogeneous
+    // block of material
+    FastShower( G4Region* region, G4Material* material );
+    ~FastShower();
+
+    // Parameterise the showers, or track them in full
+    void SetEnabled( G4bool enabled );
+
+  private:
+    GFlashShowerModel* m_model;
+    GFlashHomoShowerParameterisation* m_parameterisation;
+    GFlashParticleBounds* m_particleBounds;
+    GFlashHitMaker* m_hitMaker;
+};
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef FieldControl_h
+#define FieldControl_h 1
+
+#include "G4ThreeVector.hh"
+
+class G4UniformMagField;
+class G4FieldManager;
+class FieldControlMessenger;
+
+// The uniform magnetic field of one thread, made once in ConstructSDandField
+// and then changed in place, so the equation of motion, stepper and chord
+// finder built for it are kept between events
+// A zero field is detached from the field manager, so charged particles are
+// not propagated through a field that does nothing
+// Set with /globalField/setValue, or every event by the GeneratorAction
+class FieldControl
+{
+  public:
+    FieldControl( const G4ThreeVector& value );
+    ~FieldControl();
+
+    // The field of this thread, null before ConstructSDandField
+    static FieldControl* GetInstance() { return m_instance; }
+
+    void SetFieldValue( const G4ThreeVector& value );
+    G4ThreeVector GetFieldValue() const { return m_value; }
+
+    // Used by FieldControlMessenger, which prints what it sets
+    void SetVerboseLevel( G4int verbose ) { m_verbose = verbose; }
+    G4int GetVerboseLevel() const { return m_verbose; }
+
+  private:
+    static G4ThreadLocal FieldControl* m_instance;
+
+    G4UniformMagField* m_field;
+    G4FieldManager* m_fieldManager;
+    G4ThreeVector m_value;
+    G4int m_verbose = 0;
+    FieldControlMessenger* m_messenger;
+};
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef FieldControlMessenger_h
+#define FieldControlMessenger_h 1
+
+#include "G4UImessenger.hh"
+
+class FieldControl;
+class G4UIdirectory;
+class G4UIcmdWith3VectorAndUnit;
+class G4UIcmdWithAnInteger;
+
+// The /globalField/ commands, with the same names as G4GlobalMagFieldMessenger,
+// one messenger per thread's FieldControl
+class FieldControlMessenger : public G4UImessenger
+{
+  public:
+    FieldControlMessenger( FieldControl* fieldControl );
+    ~FieldControlMessenger() override;
+
+    void SetNewValue( G4UIcommand* command, G4String newValue ) override;
+
+  private:
+    FieldControl* m_fieldControl;
+
+    G4UIdirectory* m_directory;
+    G4UIcmdWith3VectorAndUnit* m_setValueCmd;
+    G4UIcmdWithAnInteger* m_verboseCmd;
+};
+
+#endif
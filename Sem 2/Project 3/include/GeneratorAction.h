@@ -3,21 +3,29 @@
 
 #include "G4VUserPrimaryGeneratorAction.hh"
 #include "G4ParticleGun.hh"
+#include "ScanGrid.h"
 
 
 // Generate a single particle and fire it into our experiment
+// The particle, beam energy and field follow the ScanGrid point of the event
+// number, so any number of worker threads, each with its own GeneratorAction,
+// cover the same scan, and each event is seeded from its point
 class GeneratorAction : public G4VUserPrimaryGeneratorAction
 {
   public:
-    GeneratorAction();
+    GeneratorAction( const ScanGrid* scanGrid );
     ~GeneratorAction() override;
 
     void GeneratePrimaries( G4Event* ) override;
 
+    // The scan point of the last event generated on this thread
+    const ScanGrid::Point& GetScanPoint() const { return m_scanPoint; }
+    const G4ParticleDefinition* GetScanParticle() const { return m_particleGun->GetParticleDefinition(); }
+
   private:
     G4ParticleGun* m_particleGun;
-    int runCounter;
-    class G4GlobalMagFieldMessenger* m_fieldManager;
+    const ScanGrid* m_scanGrid;
+    ScanGrid::Point m_scanPoint;
 };
 
 #endif
@@ -0,0 +1,64 @@
+#ifndef Output_h
+#define Output_h 1
+
+#include "G4VAnalysisManager.hh"
+
+#include <vector>
+
+// The Energy table, written in a format chosen on the command line before
+// any run action exists
+// - csv: one text file (the default)
+// - root: one ROOT file, compressed, worker ntuples merged by Geant4
+// - xml: one XML file per thread
+// - hdf5: one HDF5 file per thread, compressed, if Geant4 was built with HDF5
+// - bin: ColumnWriter files, compressed in chunks of rows, joined at the end
+// Everything that fills the table goes through here, on its own thread
+namespace Output
+{
+  enum Format { CSV, ROOT, XML, Binary, HDF5 };
+
+  // False for an unknown format name
+  G4bool SetFormat( const G4String& name );
+  Format GetFormat();
+
+  // Compression level of formats that support it (ROOT, HDF5, bin), 0 for none
+  void SetCompressionLevel( G4int level );
+  // Rows buffered before a chunk is written (bin)
+  void SetChunkSize( G4int rows );
+
+  // Booking, before the first run that writes the table, starting with the
+  // event number (an integer column, except in bin), which the joins sort by
+  void CreateEventColumn( const G4String& name );
+  void CreateColumn( const G4String& name );
+  void FinishTable();
+  // Drop the columns booked so far, between runs, to book a different table
+  // (for the analysis manager formats the old table stays booked, but inactive)
+  void ResetTable();
+
+  // Filling, one row per event
+  void FillEventColumn( G4long event );
+  void FillColumn( G4int column, G4double value );
+  // n consecutive columns from firstColumn, e.g. a whole detector at once
+  void FillColumns( G4int firstColumn, const G4double* values, std::size_t n );
+  void AddRow();
+
+  // File handling, once per run, with the name given without extension
+  void OpenFile( const G4String& outputName );
+  void CloseFile();
+  void Delete();
+
+  // On the master after the workers have finished: join their files, in
+  // event number order, so the result does not depend on the threads
+  void MergeWorkerFiles( const G4String& outputName, G4int nThreads );
+
+  // After a checkpointed scan: join the tables of its chunks, each a run
+  // with its own output name, into one file (csv and bin only), again in
+  // event number order, so a resumed scan gives the same file
+  // The chunk files are only removed once the join has succeeded
+  G4bool JoinChunks( const std::vector< G4String >& chunkNames, const G4String& outputName );
+
+  // Total size in bytes of the files of a run with this output name
+  G4long GetOutputSize( const G4String& outputName, G4int nThreads );
+}
+
+#endif
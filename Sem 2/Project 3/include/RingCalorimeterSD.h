@@ -0,0 +1,41 @@
+#ifndef RingCalorimeterSD_h
+#define RingCalorimeterSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+#include "G4VGFlashSensitiveDetector.hh"
+#include "G4ThreeVector.hh"
+
+#include <vector>
+
+class G4VTouchable;
+
+// The energy deposited in each silicon ring, in one array indexed by the
+// copy number of the ring volume the step is in (0 for the innermost ring),
+// or with binByRadius by the radius of the step in a single disk,
+// read by the EventAction at the end of the event
+// Energy spots from the GFlash showers of FastShower are added the same way
+class RingCalorimeterSD : public G4VSensitiveDetector, public G4VGFlashSensitiveDetector
+{
+  public:
+    RingCalorimeterSD( const G4String& name );
+
+    // Set for the geometry built, by ConstructSDandField
+    void SetRings( G4int nRings, G4double ringWidth, G4bool binByRadius );
+    ~RingCalorimeterSD() override;
+
+    void Initialize( G4HCofThisEvent* hitCollection ) override;
+    G4bool ProcessHits( G4Step* step, G4TouchableHistory* history ) override;
+    G4bool ProcessHits( G4GFlashSpot* spot, G4TouchableHistory* history ) override;
+
+    // Energy in each ring in this event
+    const std::vector< G4double >& GetRingEnergies() const { return m_ringEnergies; }
+
+  private:
+    G4int GetRadiusBin( const G4VTouchable* touchable, const G4ThreeVector& position ) const;
+
+    G4double m_ringWidth = 0.0;
+    G4bool m_binByRadius = false;
+    std::vector< G4double > m_ringEnergies;
+};
+
+#endif
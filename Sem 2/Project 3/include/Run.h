@@ -0,0 +1,40 @@
+#ifndef Run_h
+#define Run_h 1
+
+#include "G4Run.hh"
+#include "ScanHistograms.h"
+
+#include <vector>
+
+// Running statistics of the energy deposited per event in each ring, and in
+// all of them together, kept by each worker and joined on the master
+// With scanHistograms set, the reduced scan results are filled as well
+class Run : public G4Run
+{
+  public:
+    Run( G4int nRings, ScanHistograms* scanHistograms = nullptr );
+    ~Run() override;
+
+    void AddEvent( const G4String& particle, G4double beamEnergy, G4double field,
+                   const std::vector< G4double >& ringEnergies );
+    void Merge( const G4Run* run ) override;
+
+    // verbose 1: totals only, 2: a line per ring too
+    void PrintSummary( G4int verbose ) const;
+    // Null without scan histograms
+    const ScanHistograms* GetScanHistograms() const { return m_scan; }
+
+  private:
+    ScanHistograms* m_scan;
+
+    G4int m_nEvents = 0;
+    G4int m_nRings;
+    std::vector< G4double > m_sum;
+    std::vector< G4double > m_sum2;
+    std::vector< G4double > m_max;
+    G4double m_totalSum = 0.0;
+    G4double m_totalSum2 = 0.0;
+    G4double m_totalMax = 0.0;
+};
+
+#endif
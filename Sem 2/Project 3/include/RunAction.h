@@ -2,15 +2,60 @@
 #define RunAction_h 1
 
 #include "G4UserRunAction.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <chrono>
+
+class RunActionMessenger;
+class ScanGrid;
+class ScanHistograms;
 
 class RunAction : public G4UserRunAction
 {
   public:
-    RunAction();
+    RunAction( const ScanGrid* scanGrid );
     ~RunAction() override;
 
+    G4Run* GenerateRun() override;
     void BeginOfRunAction( const G4Run* ) override;
     void EndOfRunAction( const G4Run* ) override;
+
+    // Called by the SteppingAction of this thread
+    void CountStep() { ++m_nSteps; }
+    // Called by the EventAction of this thread, prints progress now and then
+    void EventDone();
+
+    // Settings, used by RunActionMessenger
+    void SetVerbose( G4int verbose ) { m_verbose = verbose; }
+    G4int GetVerbose() const { return m_verbose; }
+    void SetPrintEvery( G4int events ) { m_printEvery = events; }
+    // Fill the scan histograms in memory instead of writing the Energy table
+    void SetAccumulate( G4bool accumulate ) { m_accumulate = accumulate; }
+    G4bool GetAccumulate() const { return m_accumulate; }
+    void SetDepositBins( G4int bins ) { m_depositBins = bins; }
+    void SetMaxDeposit( G4double energy ) { m_maxDeposit = energy; }
+
+  private:
+    void BookTable( G4int nRings );
+    void WriteScan( const ScanHistograms* runScan );
+
+    // Names the output of checkpointed chunks
+    const ScanGrid* m_scanGrid;
+    // On the master, the scan histograms of all chunks of a checkpointed scan
+    ScanHistograms* m_scanTotal = nullptr;
+
+    G4int m_verbose = 1;
+    G4int m_printEvery = 1000;
+    G4bool m_accumulate = false;
+    G4int m_depositBins = 200;
+    G4double m_maxDeposit = 20.0*MeV;
+    RunActionMessenger* m_messenger;
+    // Rings in the table booked so far, 0 before the first run
+    G4int m_tableRings = 0;
+
+    G4long m_nSteps = 0;
+    G4int m_nEvents = 0;
+    std::chrono::steady_clock::time_point m_runStart;
 };
 
 #endif
@@ -0,0 +1,34 @@
+#ifndef RunActionMessenger_h
+#define RunActionMessenger_h 1
+
+#include "G4UImessenger.hh"
+
+class RunAction;
+class G4UIdirectory;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithABool;
+class G4UIcmdWithADoubleAndUnit;
+
+// The /summary/ and /histo/ commands, one messenger per thread's RunAction
+class RunActionMessenger : public G4UImessenger
+{
+  public:
+    RunActionMessenger( RunAction* runAction );
+    ~RunActionMessenger() override;
+
+    void SetNewValue( G4UIcommand* command, G4String newValue ) override;
+
+  private:
+    RunAction* m_runAction;
+
+    G4UIdirectory* m_directory;
+    G4UIcmdWithAnInteger* m_verboseCmd;
+    G4UIcmdWithAnInteger* m_printEveryCmd;
+
+    G4UIdirectory* m_histoDirectory;
+    G4UIcmdWithABool* m_accumulateCmd;
+    G4UIcmdWithAnInteger* m_depositBinsCmd;
+    G4UIcmdWithADoubleAndUnit* m_maxDepositCmd;
+};
+
+#endif
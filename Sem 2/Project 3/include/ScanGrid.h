@@ -0,0 +1,94 @@
+#ifndef ScanGrid_h
+#define ScanGrid_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+class ScanGridMessenger;
+
+// The grid of beam particles, energies and fields to scan, set with /scan/
+// Event n of a run is event firstEvent + n of the scan, which belongs to point
+// ( firstEvent + n ) / eventsPerPoint, with the field changing fastest, then
+// the energy, then the particle; after the last point the grid starts again
+// Every event is seeded from the scan seed, its point and its number within
+// the point, so a point gives the same result whichever thread or process
+// runs it, and any slice of the grid can be run on its own (/scan/run)
+// With /scan/checkpointEvery the slice is run in chunks of that many events,
+// each written to its own output files, and after each one the progress is
+// saved, so --resume can carry on after the last finished chunk
+// Shared by all threads, and only changed on the master between runs
+class ScanGrid
+{
+  public:
+    struct Point
+    {
+      G4int index = 0;
+      G4String particle; // empty: whatever /gun/particle set
+      G4double energy = 0.0;
+      G4double field = 0.0;
+      G4int event = 0; // number of the event within the point
+      G4long number = 0; // number of the event in the scan
+    };
+
+    ScanGrid();
+    ~ScanGrid();
+
+    // Values from start to stop inclusive, e.g. 200 MeV to 1190 MeV in steps of 10 MeV
+    void SetEnergies( G4double start, G4double stop, G4double step );
+    void SetFields( G4double start, G4double stop, G4double step );
+    // Space separated particle names, or an empty string for the gun's particle
+    void SetParticles( const G4String& names );
+    void SetEventsPerPoint( G4int events ) { m_eventsPerPoint = events; }
+    G4int GetEventsPerPoint() const { return m_eventsPerPoint; }
+    void SetSeed( G4long seed ) { m_seed = seed; }
+    void SetCheckpointEvery( G4int events ) { m_checkpointEvery = events; }
+    G4int GetCheckpointEvery() const { return m_checkpointEvery; }
+    void SetResume( G4bool resume ) { m_resume = resume; }
+    G4bool GetResume() const { return m_resume; }
+
+    // The part of the scan the next run covers, set by /scan/run; chunk -1
+    // for a run that is not checkpointed
+    void SetSegment( G4long firstEvent, G4int chunk ) { m_firstEvent = firstEvent; m_chunk = chunk; }
+    G4int GetChunk() const { return m_chunk; }
+    // Name of the output files of the next run, without extension
+    G4String GetOutputName() const;
+    static G4String GetOutputName( G4int chunk );
+
+    // Progress through events first to first + count of the scan, in
+    // output.checkpoint, with the random engine state in output.rndm
+    // The scan histograms of the chunk just run, if any, are kept with it
+    void SaveCheckpoint( G4long first, G4long count, G4long eventsDone, G4int nChunks ) const;
+    // False if there is no checkpoint for this slice with this grid and settings
+    G4bool LoadCheckpoint( G4long first, G4long count, G4long& eventsDone, G4int& nChunks ) const;
+    static void RemoveCheckpoint( G4int nChunks );
+    // The scan histograms after nChunks chunks of an accumulating scan, or
+    // for -1 the ones of the chunk being run, until its checkpoint is saved
+    static G4String GetScanStateName( G4int nChunks );
+
+    G4int GetNumberOfPoints() const;
+    Point GetPoint( G4int eventID ) const;
+    // Two seeds for the random engine, for one event of a point
+    void GetSeeds( const Point& point, long seeds[ 2 ] ) const;
+
+    void Print() const;
+
+  private:
+    static std::vector< G4double > MakeRange( G4double start, G4double stop, G4double step );
+    // The settings a checkpoint of this slice belongs to, as text
+    G4String DescribeSlice( G4long first, G4long count ) const;
+
+    std::vector< G4String > m_particles;
+    std::vector< G4double > m_energies;
+    std::vector< G4double > m_fields;
+    G4int m_eventsPerPoint = 10;
+    G4long m_seed = 1234;
+    G4int m_checkpointEvery = 0;
+    G4bool m_resume = false;
+    G4long m_firstEvent = 0;
+    G4int m_chunk = -1;
+
+    ScanGridMessenger* m_messenger;
+};
+
+#endif
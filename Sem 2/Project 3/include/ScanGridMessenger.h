@@ -0,0 +1,40 @@
+#ifndef ScanGridMessenger_h
+#define ScanGridMessenger_h 1
+
+#include "G4UImessenger.hh"
+
+class ScanGrid;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+
+// The /scan/ commands, setting up the grid and running all or part of it
+// The grid is shared by all threads, so these run on the master only
+class ScanGridMessenger : public G4UImessenger
+{
+  public:
+    ScanGridMessenger( ScanGrid* scanGrid );
+    ~ScanGridMessenger() override;
+
+    void SetNewValue( G4UIcommand* command, G4String newValue ) override;
+
+  private:
+    G4UIcommand* MakeRangeCommand( const G4String& name, const G4String& guidance,
+                                   const G4String& unitCategory, const G4String& defaultUnit );
+
+    void RunSlice( G4long first, G4long count );
+
+    ScanGrid* m_scanGrid;
+
+    G4UIdirectory* m_directory;
+    G4UIcommand* m_energiesCmd;
+    G4UIcommand* m_fieldsCmd;
+    G4UIcmdWithAString* m_particlesCmd;
+    G4UIcmdWithAnInteger* m_eventsPerPointCmd;
+    G4UIcmdWithAnInteger* m_seedCmd;
+    G4UIcmdWithAnInteger* m_checkpointEveryCmd;
+    G4UIcommand* m_runCmd;
+};
+
+#endif
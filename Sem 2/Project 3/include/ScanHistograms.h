@@ -0,0 +1,52 @@
+#ifndef ScanHistograms_h
+#define ScanHistograms_h 1
+
+#include "globals.hh"
+
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// The reduced results of an energy and field scan, filled in memory
+// instead of writing a row per event
+// - for each (particle, beam energy, field) point: the number of events, and
+//   the mean and RMS of the energy deposited in each ring
+// - for each particle and beam energy: a 2D histogram of ring against deposited energy
+//   (the field is left out, as ring x bins for every scan point would take
+//   about as much memory as the events themselves)
+class ScanHistograms
+{
+  public:
+    ScanHistograms( G4int nRings, G4int depositBins, G4double maxDeposit );
+
+    void AddEvent( const G4String& particle, G4double beamEnergy, G4double field,
+                   const std::vector< G4double >& ringEnergies );
+    void Merge( const ScanHistograms& other );
+
+    // <outputName>_scan.csv and <outputName>_profile.csv, returns the bytes written
+    G4long Write( const G4String& outputName ) const;
+
+    // The exact sums after nChunks chunks of a scan, to carry on filling in a
+    // later job (binary, this machine only)
+    void Save( const G4String& fileName, G4int nChunks ) const;
+    // False if the file is missing, damaged, or has a different chunk count, rings or binning
+    G4bool Load( const G4String& fileName, G4int nChunks );
+
+  private:
+    struct ScanPoint
+    {
+      G4int nEvents = 0;
+      std::vector< G4double > sum;
+      std::vector< G4double > sum2;
+    };
+
+    G4int m_nRings;
+    G4int m_depositBins;
+    G4double m_maxDeposit;
+    std::map< std::tuple< G4String, G4double, G4double >, ScanPoint > m_points;
+    // Ring-major bin counts, with an overflow bin at the end of each ring
+    std::map< std::pair< G4String, G4double >, std::vector< G4int > > m_profiles;
+};
+
+#endif
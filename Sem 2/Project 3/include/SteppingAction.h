@@ -0,0 +1,21 @@
+#ifndef SteppingAction_h
+#define SteppingAction_h 1
+
+#include "G4UserSteppingAction.hh"
+
+class RunAction;
+
+// Counts the steps of each run, to see where the tracking time goes
+class SteppingAction : public G4UserSteppingAction
+{
+  public:
+    SteppingAction( RunAction* runAction );
+    ~SteppingAction() override;
+
+    void UserSteppingAction( const G4Step* step ) override;
+
+  private:
+    RunAction* m_runAction;
+};
+
+#endif
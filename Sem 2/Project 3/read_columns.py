@@ -0,0 +1,46 @@
+"""Read the binary column files written with "-o bin" (output_nt_Energy.bin)
+into a pandas DataFrame, the same table read_csv gives for the CSV output.
+
+    from read_columns import read_columns
+    e_energy = read_columns("output_nt_Energy.bin")
+
+The layout is described in include/ColumnWriter.h.
+"""
+import struct
+import zlib
+
+import numpy as np
+import pandas as pd
+
+
+def read_columns(file_name):
+    with open(file_name, "rb") as f:
+        data = f.read()
+
+    if data[:8] != b"P3COLS01":
+        raise ValueError(file_name + " is not a column file")
+    pos = 8
+    (n_columns,) = struct.unpack_from("=I", data, pos)
+    pos += 4
+    names = []
+    for _ in range(n_columns):
+        (length,) = struct.unpack_from("=I", data, pos)
+        pos += 4
+        names.append(data[pos:pos + length].decode())
+        pos += length
+
+    # Each chunk holds every column for a block of rows
+    chunks = [[] for _ in names]
+    while pos < len(data):
+        n_rows, level = struct.unpack_from("=II", data, pos)
+        pos += 8
+        for column in range(n_columns):
+            (size,) = struct.unpack_from("=Q", data, pos)
+            pos += 8
+            stored = data[pos:pos + size]
+            pos += size
+            raw = zlib.decompress(stored) if level > 0 else stored
+            chunks[column].append(np.frombuffer(raw, dtype=np.float64, count=n_rows))
+
+    return pd.DataFrame({name: np.concatenate(chunk) if chunk else np.empty(0)
+                         for name, chunk in zip(names, chunks)})
@@ -2,8 +2,9 @@
 #include "GeneratorAction.h"
 #include "RunAction.h"
 #include "EventAction.h"
+#include "SteppingAction.h"
 
-ActionInitialization::ActionInitialization() : G4VUserActionInitialization()
+ActionInitialization::ActionInitialization( const ScanGrid* scanGrid ) : G4VUserActionInitialization(), m_scanGrid( scanGrid )
 {
 }
 
@@ -11,13 +12,23 @@ ActionInitialization::~ActionInitialization()
 {
 }
 
-// Three actions to set up
+// The master thread only controls the run, and joins the worker output at the end
+void ActionInitialization::BuildForMaster() const
+{
+  this->SetUserAction( new RunAction( m_scanGrid ) );
+}
+
+// Actions to set up for each worker thread
 // - generating particles
 // - controlling the whole run
 // - controlling a single event
+// - counting steps
 void ActionInitialization::Build() const
 {
-  this->SetUserAction( new GeneratorAction() );
-  this->SetUserAction( new RunAction() );
-  this->SetUserAction( new EventAction() );
+  auto runAction = new RunAction( m_scanGrid );
+  auto generatorAction = new GeneratorAction( m_scanGrid );
+  this->SetUserAction( generatorAction );
+  this->SetUserAction( runAction );
+  this->SetUserAction( new EventAction( runAction, generatorAction ) );
+  this->SetUserAction( new SteppingAction( runAction ) );
 }
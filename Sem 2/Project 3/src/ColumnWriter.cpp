@@ -0,0 +1,267 @@
+#include "ColumnWriter.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+
+namespace
+{
+  const char magic[] = "P3COLS01";
+  const std::size_t magicLength = 8;
+
+  template< typename T > void WriteValue( std::ostream& output, T value )
+  {
+    output.write( reinterpret_cast< const char* >( &value ), sizeof( T ) );
+  }
+
+  template< typename T > G4bool ReadValue( std::istream& input, T& value )
+  {
+    return bool( input.read( reinterpret_cast< char* >( &value ), sizeof( T ) ) );
+  }
+
+  // The magic, column count and names of a file, as stored; false if it is not a column file
+  G4bool ReadHeader( std::ifstream& input, std::string& header, std::vector< G4String >& names )
+  {
+    names.clear();
+    header.assign( magicLength + sizeof( std::uint32_t ), '\0' );
+    input.read( &header[0], header.size() );
+    std::uint32_t nColumns = 0;
+    std::memcpy( &nColumns, &header[ magicLength ], sizeof( nColumns ) );
+    for ( std::uint32_t column = 0; input && column < nColumns; ++column )
+    {
+      std::uint32_t length = 0;
+      input.read( reinterpret_cast< char* >( &length ), sizeof( length ) );
+      std::string name( length, '\0' );
+      input.read( &name[0], length );
+      header.append( reinterpret_cast< const char* >( &length ), sizeof( length ) );
+      header += name;
+      names.push_back( name );
+    }
+    return input && header.compare( 0, magicLength, magic ) == 0;
+  }
+
+  // Append the values of every chunk after the header to columns, one
+  // vector per column; false if a chunk is cut short or does not decompress
+  G4bool ReadChunks( std::ifstream& input, std::vector< std::vector< G4double > >& columns )
+  {
+    std::uint32_t nRows = 0;
+    std::vector< char > stored;
+    while ( ReadValue( input, nRows ) )
+    {
+      std::uint32_t level = 0;
+      if ( !ReadValue( input, level ) ) return false;
+      for ( auto& column : columns )
+      {
+        std::uint64_t size = 0;
+        if ( !ReadValue( input, size ) ) return false;
+        stored.resize( size );
+        if ( !input.read( stored.data(), size ) ) return false;
+
+        std::size_t first = column.size();
+        uLongf rawSize = nRows * sizeof( G4double );
+        column.resize( first + nRows );
+        Bytef* raw = reinterpret_cast< Bytef* >( column.data() + first );
+        if ( level > 0 )
+        {
+          uLongf expected = rawSize;
+          if ( uncompress( raw, &rawSize, reinterpret_cast< const Bytef* >( stored.data() ), size ) != Z_OK
+               || rawSize != expected ) return false;
+        }
+        else if ( size != rawSize ) return false;
+        else std::memcpy( raw, stored.data(), size );
+      }
+    }
+    // Only a clean end of file between chunks
+    return input.eof() && input.gcount() == 0;
+  }
+}
+
+ColumnWriter::ColumnWriter()
+{
+}
+
+ColumnWriter::~ColumnWriter()
+{
+  this->Close();
+}
+
+void ColumnWriter::AddColumn( const G4String& name )
+{
+  m_names.push_back( name );
+}
+
+G4bool ColumnWriter::Open( const G4String& fileName, G4int compressionLevel, G4int chunkRows )
+{
+  this->Close();
+  m_file.open( fileName, std::ios::binary | std::ios::trunc );
+  if ( !m_file )
+  {
+    G4cerr << "ColumnWriter: cannot open " << fileName << G4endl;
+    return false;
+  }
+
+  m_compressionLevel = compressionLevel;
+  m_chunkRows = chunkRows > 0 ? chunkRows : 1;
+  m_row.assign( m_names.size(), 0.0 );
+  m_columns.assign( m_names.size(), std::vector< G4double >() );
+  for ( auto& column : m_columns ) column.reserve( m_chunkRows );
+  m_nRows = 0;
+
+  this->WriteHeader();
+  return true;
+}
+
+void ColumnWriter::Fill( G4int column, G4double value )
+{
+  m_row[ column ] = value;
+}
+
+void ColumnWriter::Fill( G4int firstColumn, const G4double* values, std::size_t n )
+{
+  std::memcpy( &m_row[ firstColumn ], values, n * sizeof( G4double ) );
+}
+
+// Move the row into the chunk, and start the next one from zero
+void ColumnWriter::AddRow()
+{
+  for ( std::size_t column = 0; column < m_row.size(); ++column )
+  {
+    m_columns[ column ].push_back( m_row[ column ] );
+    m_row[ column ] = 0.0;
+  }
+  if ( ++m_nRows == m_chunkRows ) this->WriteChunk();
+}
+
+void ColumnWriter::Close()
+{
+  if ( !m_file.is_open() ) return;
+  if ( m_nRows > 0 ) this->WriteChunk();
+  m_file.close();
+}
+
+void ColumnWriter::WriteHeader()
+{
+  m_file.write( magic, magicLength );
+  WriteValue< std::uint32_t >( m_file, m_names.size() );
+  for ( const auto& name : m_names )
+  {
+    WriteValue< std::uint32_t >( m_file, name.size() );
+    m_file.write( name.data(), name.size() );
+  }
+}
+
+void ColumnWriter::WriteChunk()
+{
+  WriteValue< std::uint32_t >( m_file, m_nRows );
+  WriteValue< std::uint32_t >( m_file, m_compressionLevel );
+  for ( auto& column : m_columns )
+  {
+    const Bytef* data = reinterpret_cast< const Bytef* >( column.data() );
+    uLong size = column.size() * sizeof( G4double );
+    if ( m_compressionLevel > 0 )
+    {
+      uLongf storedSize = compressBound( size );
+      if ( m_buffer.size() < storedSize ) m_buffer.resize( storedSize );
+      int status = compress2( m_buffer.data(), &storedSize, data, size, m_compressionLevel );
+      if ( status != Z_OK )
+      {
+        // Stop writing, rather than store a chunk that cannot be read back
+        G4cerr << "ColumnWriter: compression failed (zlib error " << status << "), the file is incomplete" << G4endl;
+        m_file.setstate( std::ios::badbit );
+        break;
+      }
+      WriteValue< std::uint64_t >( m_file, storedSize );
+      m_file.write( reinterpret_cast< const char* >( m_buffer.data() ), storedSize );
+    }
+    else
+    {
+      WriteValue< std::uint64_t >( m_file, size );
+      m_file.write( reinterpret_cast< const char* >( data ), size );
+    }
+    column.clear();
+  }
+  m_nRows = 0;
+}
+
+// Every input is read before anything is written, and the output is written
+// under a temporary name, so a failed merge leaves the inputs as they were
+// and no partial output
+// The rows are written in chunks of chunkRows as they come after sorting, so
+// the result is the file one writer would have made from the sorted rows
+G4bool ColumnWriter::Merge( const std::vector< G4String >& inputNames, const G4String& outputName,
+                            G4int compressionLevel, G4int chunkRows )
+{
+  // The first file sets the columns, the others must match
+  std::string header;
+  std::vector< G4String > names;
+  std::vector< std::vector< G4double > > columns;
+  std::vector< G4String > mergeNames;
+  for ( const auto& inputName : inputNames )
+  {
+    std::ifstream input( inputName, std::ios::binary );
+    if ( !input ) continue;
+
+    std::string fileHeader;
+    std::vector< G4String > fileNames;
+    if ( !ReadHeader( input, fileHeader, fileNames ) )
+    {
+      G4cerr << "ColumnWriter: " << inputName << " is not a column file" << G4endl;
+      return false;
+    }
+    if ( header.empty() )
+    {
+      header = fileHeader;
+      names = fileNames;
+      columns.resize( names.size() );
+    }
+    else if ( fileHeader != header )
+    {
+      G4cerr << "ColumnWriter: " << inputName << " has different columns" << G4endl;
+      return false;
+    }
+    if ( !ReadChunks( input, columns ) )
+    {
+      G4cerr << "ColumnWriter: " << inputName << " is damaged" << G4endl;
+      return false;
+    }
+    mergeNames.push_back( inputName );
+  }
+  if ( mergeNames.empty() ) return true;
+
+  // Sort the rows by the first column, keeping the input order of equal ones
+  std::size_t nRows = columns.empty() ? 0 : columns[0].size();
+  std::vector< std::size_t > order( nRows );
+  std::iota( order.begin(), order.end(), 0 );
+  if ( !columns.empty() )
+  {
+    const std::vector< G4double >& key = columns[0];
+    std::stable_sort( order.begin(), order.end(),
+                      [&key]( std::size_t a, std::size_t b ) { return key[ a ] < key[ b ]; } );
+  }
+
+  G4String temporary = outputName + ".tmp";
+  {
+    ColumnWriter output;
+    for ( const auto& name : names ) output.AddColumn( name );
+    G4bool opened = output.Open( temporary, compressionLevel, chunkRows );
+    for ( std::size_t row = 0; opened && row < nRows; ++row )
+    {
+      for ( std::size_t column = 0; column < columns.size(); ++column ) output.m_row[ column ] = columns[ column ][ order[ row ] ];
+      output.AddRow();
+    }
+    output.Close();
+    if ( !opened || !output.m_file || std::rename( temporary.c_str(), outputName.c_str() ) != 0 )
+    {
+      G4cerr << "ColumnWriter: could not write " << outputName << ", keeping its inputs" << G4endl;
+      std::remove( temporary.c_str() );
+      return false;
+    }
+  }
+
+  for ( const auto& inputName : mergeNames ) std::remove( inputName.c_str() );
+  return true;
+}
@@ -1,5 +1,8 @@
 #include "DetectorConstruction.h"
-#include "EnergyCounter.h"
+#include "DetectorMessenger.h"
+#include "RingCalorimeterSD.h"
+#include "FieldControl.h"
+#include "FastShower.h"
 
 #include "G4Material.hh"
 #include "G4NistManager.hh"
@@ -7,40 +10,125 @@
 #include "G4Tubs.hh"
 #include "G4LogicalVolume.hh"
 #include "G4PVPlacement.hh"
+#include "G4PVReplica.hh"
 #include "G4AutoDelete.hh"
 #include "G4GeometryManager.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4SDManager.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4ProductionCuts.hh"
+#include "G4UserLimits.hh"
 #include <G4VisAttributes.hh>
 #include <G4Colour.hh>
 #include "Consts.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+G4ThreadLocal
+FieldControl* DetectorConstruction::m_fieldControl = 0;
 G4ThreadLocal
-G4GlobalMagFieldMessenger* DetectorConstruction::m_magneticFieldMessenger = 0;
+FastShower* DetectorConstruction::m_fastShower = 0;
+
+namespace
+{
+  // Find or make a region, with its own production cut if it has none yet
+  G4Region* MakeRegion( const G4String& name, G4double cut )
+  {
+    G4Region* region = G4RegionStore::GetInstance()->GetRegion( name, false );
+    if ( !region ) region = new G4Region( name );
+    if ( !region->GetProductionCuts() )
+    {
+      G4ProductionCuts* cuts = new G4ProductionCuts();
+      cuts->SetProductionCut( cut );
+      region->SetProductionCuts( cuts );
+    }
+    return region;
+  }
+}
 
 DetectorConstruction::DetectorConstruction() : G4VUserDetectorConstruction()
 {
+  m_detectorLimits = new G4UserLimits();
+  m_absorberLimits = new G4UserLimits();
+  m_worldLimits = new G4UserLimits();
+  m_messenger = new DetectorMessenger( this );
 }
 
 DetectorConstruction::~DetectorConstruction()
 {
+  delete m_messenger;
+  delete m_detectorLimits;
+  delete m_absorberLimits;
+  delete m_worldLimits;
+}
+
+// Rounded down, so the rings never reach past the absorber; the small margin
+// keeps e.g. 100 cm in rings of 1 cm at 100 rings despite rounding errors
+G4int DetectorConstruction::GetNumberOfRings() const
+{
+  return std::max( G4int( std::floor( m_radius / m_ringWidth + 1e-9 ) ), 1 );
+}
+
+G4bool DetectorConstruction::SetRadius( G4double radius )
+{
+  if ( radius > worldHalfLength || radius < m_ringWidth ) return false;
+  m_radius = radius;
+  return true;
+}
+
+G4bool DetectorConstruction::SetRingWidth( G4double width )
+{
+  if ( width > m_radius ) return false;
+  m_ringWidth = width;
+  return true;
+}
+
+// The absorber sits in front of the silicon, and both must be inside the world
+G4bool DetectorConstruction::SetAbsorberThickness( G4double thickness )
+{
+  if ( detectorHalfThickness + thickness > worldHalfLength ) return false;
+  m_absorberThickness = thickness;
+  return true;
+}
+
+G4bool DetectorConstruction::SetAbsorberMaterial( const G4String& name )
+{
+  if ( !G4NistManager::Instance()->FindOrBuildMaterial( name ) ) return false;
+  m_absorberMaterial = name;
+  return true;
+}
+
+G4UserLimits* DetectorConstruction::GetUserLimits( const G4String& regionName )
+{
+  if ( regionName == "Detector" ) return m_detectorLimits;
+  if ( regionName == "Absorber" ) return m_absorberLimits;
+  if ( regionName == "World" ) return m_worldLimits;
+  return 0;
 }
 
 // Here we define the actual experiment that we want to perform
 G4VPhysicalVolume* DetectorConstruction::Construct()
 {
+  auto buildStart = std::chrono::steady_clock::now();
+
   // Materials
   // http://geant4-userdoc.web.cern.ch/geant4-userdoc/UsersGuides/ForApplicationDeveloper/html/Appendix/materialNames.html
   G4NistManager* nistManager = G4NistManager::Instance();
   G4Material* vacuum = nistManager->FindOrBuildMaterial( "G4_Galactic" );
-  G4Material* lead = nistManager->FindOrBuildMaterial( "G4_Pb" );
+  G4Material* absorberMaterial = nistManager->FindOrBuildMaterial( m_absorberMaterial ); // lead by default
   // Amendment silicon
   G4Material* silicon = nistManager->FindOrBuildMaterial("G4_Si");
 
   // Sizes of the principal geometrical components (solids)
-  G4double absorberThickness = 0.1*cm;
-  G4double detectorThickness = 5.0*cm;
-  G4double worldLength = 250.0*cm;
+  G4double absorberThickness = 0.5*m_absorberThickness; // half length
+  G4double radius = m_radius;
+  G4double detectorRingWidth = m_ringWidth;
+  G4int numRings = this->GetNumberOfRings();
+  G4double detectorThickness = detectorHalfThickness;
+  G4double worldLength = worldHalfLength;
 
   // Definitions of Solids, Logical Volumes, Physical Volumes
 
@@ -83,7 +171,7 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   // ABSORBER: Logical volume (how to treat it)
   G4LogicalVolume* absorberLV = new G4LogicalVolume(
     absorberS,         // its solid
-    lead,              // its material
+    absorberMaterial,  // its material
     "Absorber",      // its name
     0, 0, 0 );         // Modifiers we don't use
   G4VisAttributes* absorberVisAtt = new G4VisAttributes(G4Colour(131.0/255.0, 136.0/255.0, 145.0/255.0));
@@ -103,36 +191,122 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   // ABSORBER: Quit if there's an overlap
   if ( absorberPV->CheckOverlaps() ) std::cerr << "WARNING: your simulated objects overlap" << std::endl;
 
-  layerNum = 0;
-  // Detector
-  for(G4double outerRadius = detectorRingWidth;
-      outerRadius <= radius; outerRadius += detectorRingWidth)
+  // REGIONS: the shower only needs to be resolved where energy is scored,
+  // so the rings keep the standard 0.7 mm cut while the absorber gets a coarse one
+  // (change them with /run/setCutForRegion Detector ... and /run/setCut)
+  G4Region* absorberRegion = MakeRegion( "Absorber", 2.0*mm );
+  absorberRegion->AddRootLogicalVolume( absorberLV );
+  G4Region* detectorRegion = MakeRegion( "Detector", 0.7*mm );
+
+  // Step limits, set with the /det/ commands (G4StepLimiterPhysics applies them)
+  absorberLV->SetUserLimits( m_absorberLimits );
+  worldLV->SetUserLimits( m_worldLimits );
+
+  // DETECTOR: the silicon rings, numbered by copy number from 0 at the centre
+  m_ringLVs.clear();
+  if ( m_ringLayout == "placement" )
+  {
+    // One volume per ring, all placed in the world: kept for comparison
+    for(G4int ring = 0; ring < numRings; ring++)
+    {
+      G4double outerRadius = detectorRingWidth * (ring + 1);
+      G4Tubs* ringS = new G4Tubs(
+        "Ring",
+        detectorRingWidth * ring,
+        outerRadius,
+        detectorThickness,
+        0.0*deg,
+        360.0*deg);
+
+      G4LogicalVolume* ringLV = new G4LogicalVolume(
+        ringS,
+        silicon,
+        "Ring",
+        0,0,0);
+      G4VisAttributes* detectorVisAtt = new G4VisAttributes(G4Colour(outerRadius/radius,
+                                                                    outerRadius/radius,
+                                                                    outerRadius/radius));
+      ringLV-> SetVisAttributes(detectorVisAtt);
+      ringLV->SetUserLimits( m_detectorLimits );
+      detectorRegion->AddRootLogicalVolume( ringLV );
+      m_ringLVs.push_back( ringLV );
+
+      G4VPhysicalVolume* ringPV = new G4PVPlacement(
+        0,
+        G4ThreeVector(0,0,0),
+        ringLV,
+        "Ring",
+        worldLV,
+        false,
+        ring,
+        true);
+
+      // DETECTOR: Warn if there's an overlap
+      if ( ringPV->CheckOverlaps() ) std::cerr << "WARNING: your simulated objects overlap" << std::endl;
+    }
+  }
+  else if ( m_ringLayout == "disk" )
   {
-    layerNum++;
-    std::string detectorName = "Detector" + std::to_string(layerNum);
+    // One silicon disk: the sensitive detector finds the ring from the radius
+    // of each step, and any finer binning comes from a /score/ mesh
+    G4Tubs* diskS = new G4Tubs(
+      "Detector",
+      0.0,
+      detectorRingWidth * numRings,
+      detectorThickness,
+      0.0*deg,
+      360.0*deg);
+
+    G4LogicalVolume* diskLV = new G4LogicalVolume(
+      diskS,
+      silicon,
+      "Detector",
+      0,0,0);
+    diskLV->SetVisAttributes(new G4VisAttributes(G4Colour(0.6, 0.6, 0.6)));
+    diskLV->SetUserLimits( m_detectorLimits );
+    detectorRegion->AddRootLogicalVolume( diskLV );
+    m_ringLVs.push_back( diskLV );
+
+    G4VPhysicalVolume* diskPV = new G4PVPlacement(
+      0,
+      G4ThreeVector(0,0,0),
+      diskLV,
+      "Detector",
+      worldLV,
+      false,
+      0,
+      true);
+
+    // DETECTOR: Warn if there's an overlap
+    if ( diskPV->CheckOverlaps() ) std::cerr << "WARNING: your simulated objects overlap" << std::endl;
+  }
+  else
+  {
+    // DETECTOR: Solid (tube) holding all the rings
     G4Tubs* detectorS = new G4Tubs(
-      detectorName,
-      detectorRingWidth * (layerNum -1),
-      outerRadius,
+      "Detector",
+      0.0,
+      detectorRingWidth * numRings,
       detectorThickness,
       0.0*deg,
       360.0*deg);
 
+    // DETECTOR: Logical volume, filled with rings so it is never seen itself
     G4LogicalVolume* detectorLV = new G4LogicalVolume(
       detectorS,
       silicon,
-      detectorName,
+      "Detector",
       0,0,0);
-    G4VisAttributes* detectorVisAtt = new G4VisAttributes(G4Colour(outerRadius/radius,
-                                                                  outerRadius/radius,
-                                                                  outerRadius/radius));
-    detectorLV-> SetVisAttributes(detectorVisAtt);
+    detectorLV->SetVisAttributes( G4VisAttributes::GetInvisible() );
+    detectorLV->SetUserLimits( m_detectorLimits );
+    detectorRegion->AddRootLogicalVolume( detectorLV );
 
+    // DETECTOR: Physical volume (where is it)
     G4VPhysicalVolume* detectorPV = new G4PVPlacement(
       0,
       G4ThreeVector(0,0,0),
       detectorLV,
-      detectorName,
+      "Detector",
       worldLV,
       false,
       0,
@@ -140,30 +314,80 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
 
     // DETECTOR: Warn if there's an overlap
     if ( detectorPV->CheckOverlaps() ) std::cerr << "WARNING: your simulated objects overlap" << std::endl;
+
+    // RING: one ring, replicated along the radius to fill the detector, so
+    // the navigator has a single daughter of the world and finds the ring
+    // from the radius instead of checking each one
+    G4Tubs* ringS = new G4Tubs(
+      "Ring",
+      0.0,
+      detectorRingWidth,
+      detectorThickness,
+      0.0*deg,
+      360.0*deg);
+
+    G4LogicalVolume* ringLV = new G4LogicalVolume(
+      ringS,
+      silicon,
+      "Ring",
+      0,0,0);
+    ringLV->SetVisAttributes(new G4VisAttributes(G4Colour(0.6, 0.6, 0.6)));
+    ringLV->SetUserLimits( m_detectorLimits );
+    m_ringLVs.push_back( ringLV );
+
+    new G4PVReplica(
+      "Ring",
+      ringLV,
+      detectorLV,
+      kRho,              // replicated in radius
+      numRings,
+      detectorRingWidth,
+      0.0 );             // starting at the centre
   }
 
+  G4double buildTime = std::chrono::duration< G4double >( std::chrono::steady_clock::now() - buildStart ).count();
+  G4cout << "DetectorConstruction: " << numRings << " rings (" << m_ringLayout << ") built in "
+         << buildTime << " s" << G4endl;
+
   // Always return the physical world
   return worldPV;
 }
 
 // Set up the magnetic field
+// This runs again on each thread when the geometry is rebuilt between runs,
+// so whatever outlives the volumes is only made the first time
 void DetectorConstruction::ConstructSDandField()
 {
-  // Create global magnetic field messenger.
-  // Uniform magnetic field is then created automatically if
-  // the field value is not zero.
-  G4ThreeVector fieldValue = G4ThreeVector();
-  m_magneticFieldMessenger = new G4GlobalMagFieldMessenger( fieldValue );
+  // Create the uniform magnetic field of this thread, off until set
+  // (by /globalField/setValue, or the scan in the GeneratorAction)
+  if ( !m_fieldControl )
+  {
+    G4ThreeVector fieldValue = G4ThreeVector();
+    m_fieldControl = new FieldControl( fieldValue );
 
-  // Register the field messenger for deleting
-  G4AutoDelete::Register( m_magneticFieldMessenger );
+    // Register the field for deleting
+    G4AutoDelete::Register( m_fieldControl );
+  }
+
+  // Amendment one sensitive detector for all the silicon rings, which
+  // tells them apart by copy number, or by radius for the single disk
+  auto detector = static_cast< RingCalorimeterSD* >( G4SDManager::GetSDMpointer()->FindSensitiveDetector( "Detector", false ) );
+  if ( !detector )
+  {
+    detector = new RingCalorimeterSD( "Detector" );
+    G4SDManager::GetSDMpointer()->AddNewDetector( detector );
+  }
+  detector->SetRings( this->GetNumberOfRings(), m_ringWidth, m_ringLayout == "disk" );
+  for ( auto ringLV : m_ringLVs ) this->SetSensitiveDetector(ringLV, detector);
 
-  // Amendment make sensitive detectors for the outer silicon layer
-  for(int layer = 1; layer<=layerNum; layer++)
+  // GFlash showers in the silicon, off until /det/fastShowers true
+  // (the absorber is a third of a radiation length of lead, so the showers develop in the rings)
+  if ( !m_fastShower )
   {
-    std::string detectorName = "Detector" + std::to_string(layer);
-    auto detector = new EnergyCounter(detectorName, layer);
-    G4SDManager::GetSDMpointer()->AddNewDetector(detector);
-    this->SetSensitiveDetector(detectorName, detector);
+    G4Region* detectorRegion = G4RegionStore::GetInstance()->GetRegion( "Detector" );
+    G4Material* silicon = G4NistManager::Instance()->FindOrBuildMaterial( "G4_Si" );
+    m_fastShower = new FastShower( detectorRegion, silicon );
+    G4AutoDelete::Register( m_fastShower );
   }
+  m_fastShower->SetEnabled( m_fastShowers );
 }
@@ -0,0 +1,161 @@
+#include "DetectorMessenger.h"
+#include "DetectorConstruction.h"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UserLimits.hh"
+#include "G4RunManager.hh"
+#include "G4StateManager.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <sstream>
+
+DetectorMessenger::DetectorMessenger( DetectorConstruction* detector ) : G4UImessenger(), m_detector( detector )
+{
+  m_directory = new G4UIdirectory( "/det/" );
+  m_directory->SetGuidance( "Detector layout, regions and their step limits" );
+  m_directory->SetGuidance( "Production cuts per region are set with /run/setCutForRegion" );
+
+  m_maxStepCmd = this->MakeLimitCommand( "maxStep", "Longest step allowed in the region", "Length", "mm" );
+  m_maxTrackLengthCmd = this->MakeLimitCommand( "maxTrackLength", "Stop tracks that have travelled further than this in the region", "Length", "m" );
+  m_minKineticEnergyCmd = this->MakeLimitCommand( "minKineticEnergy", "Stop tracks below this kinetic energy in the region", "Energy", "MeV" );
+
+  m_ringLayoutCmd = new G4UIcmdWithAString( "/det/ringLayout", this );
+  m_ringLayoutCmd->SetGuidance( "How the silicon rings are built" );
+  m_ringLayoutCmd->SetGuidance( "replica: one cylinder divided in radius (fast), placement: one volume per ring" );
+  m_ringLayoutCmd->SetGuidance( "disk: one cylinder, the rings are bins in the radius of each step (use with a /score/ mesh)" );
+  m_ringLayoutCmd->SetParameterName( "layout", false );
+  m_ringLayoutCmd->SetCandidates( "replica placement disk" );
+  m_ringLayoutCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+  m_ringLayoutCmd->SetToBeBroadcasted( false );
+
+  m_radiusCmd = this->MakeSizeCommand( "radius", "Outer radius of the detector and the absorber, inside the 250 cm world", defaultRadius );
+  m_ringWidthCmd = this->MakeSizeCommand( "ringWidth", "Width of each silicon ring, the radius holds as many as fit", defaultRingWidth );
+  m_absorberThicknessCmd = this->MakeSizeCommand( "absorberThickness", "Thickness of the absorber along the beam, in front of the 10 cm of silicon", defaultAbsorberThickness );
+
+  m_materialCmd = new G4UIcmdWithAString( "/det/material", this );
+  m_materialCmd->SetGuidance( "NIST material of the absorber, e.g. G4_Pb (default), G4_W, G4_Fe" );
+  m_materialCmd->SetParameterName( "material", false );
+  m_materialCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+  m_materialCmd->SetToBeBroadcasted( false );
+
+  m_fastShowersCmd = new G4UIcmdWithABool( "/det/fastShowers", this );
+  m_fastShowersCmd->SetGuidance( "Parameterise electron and positron showers in the rings with GFlash (off by default)" );
+  m_fastShowersCmd->SetGuidance( "The default GFlash tuning, not yet checked against full simulation: see fastsim.mac" );
+  m_fastShowersCmd->SetParameterName( "fastShowers", true );
+  m_fastShowersCmd->SetDefaultValue( true );
+  m_fastShowersCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+  m_fastShowersCmd->SetToBeBroadcasted( false );
+}
+
+DetectorMessenger::~DetectorMessenger()
+{
+  delete m_maxStepCmd;
+  delete m_maxTrackLengthCmd;
+  delete m_minKineticEnergyCmd;
+  delete m_ringLayoutCmd;
+  delete m_radiusCmd;
+  delete m_ringWidthCmd;
+  delete m_absorberThicknessCmd;
+  delete m_materialCmd;
+  delete m_fastShowersCmd;
+  delete m_directory;
+}
+
+// Each size takes a value and a unit, e.g. /det/ringWidth 5 mm
+G4UIcmdWithADoubleAndUnit* DetectorMessenger::MakeSizeCommand( const G4String& name, const G4String& guidance, G4double defaultValue )
+{
+  G4UIcmdWithADoubleAndUnit* command = new G4UIcmdWithADoubleAndUnit( "/det/" + name, this );
+  command->SetGuidance( guidance );
+  command->SetGuidance( "Default " + G4UIcommand::ConvertToString( defaultValue / mm ) + " mm" );
+  command->SetParameterName( name, false );
+  command->SetRange( name + " > 0" );
+  command->SetUnitCategory( "Length" );
+  command->SetDefaultUnit( "mm" );
+  command->AvailableForStates( G4State_PreInit, G4State_Idle );
+  command->SetToBeBroadcasted( false );
+  return command;
+}
+
+// Before /run/initialize the geometry is built with the new values anyway;
+// after it, the old volumes are deleted and the next /run/beamOn builds new
+// ones (with the sensitive detector, run statistics and output table sized
+// to the new number of rings, and the GFlash model of each thread switched)
+// without touching the physics tables
+void DetectorMessenger::ReinitializeGeometry()
+{
+  if ( G4StateManager::GetStateManager()->GetCurrentState() != G4State_Idle ) return;
+  G4RunManager::GetRunManager()->ReinitializeGeometry( true );
+}
+
+// Each limit takes a region name, a value and a unit, e.g. /det/maxStep Detector 1 mm
+G4UIcommand* DetectorMessenger::MakeLimitCommand( const G4String& name, const G4String& guidance,
+                                                  const G4String& unitCategory, const G4String& defaultUnit )
+{
+  G4UIcommand* command = new G4UIcommand( "/det/" + name, this );
+  command->SetGuidance( guidance );
+  command->SetGuidance( "A value of 0 removes the limit" );
+  G4UIparameter* regionParameter = new G4UIparameter( "region", 's', false );
+  regionParameter->SetParameterCandidates( DetectorConstruction::GetRegionNames() );
+  command->SetParameter( regionParameter );
+  G4UIparameter* valueParameter = new G4UIparameter( "value", 'd', false );
+  valueParameter->SetParameterRange( "value >= 0" );
+  command->SetParameter( valueParameter );
+  G4UIparameter* unitParameter = new G4UIparameter( "unit", 's', true );
+  unitParameter->SetDefaultValue( defaultUnit );
+  unitParameter->SetParameterCandidates( G4UIcommand::UnitsList( unitCategory ) );
+  command->SetParameter( unitParameter );
+  command->AvailableForStates( G4State_PreInit, G4State_Idle );
+  command->SetToBeBroadcasted( false );
+  return command;
+}
+
+void DetectorMessenger::SetNewValue( G4UIcommand* command, G4String newValue )
+{
+  if ( command == m_ringLayoutCmd || command == m_radiusCmd || command == m_ringWidthCmd
+       || command == m_absorberThicknessCmd || command == m_materialCmd || command == m_fastShowersCmd )
+  {
+    if ( command == m_ringLayoutCmd ) m_detector->SetRingLayout( newValue );
+    else if ( command == m_fastShowersCmd ) m_detector->SetFastShowers( m_fastShowersCmd->GetNewBoolValue( newValue ) );
+    else if ( command == m_radiusCmd && !m_detector->SetRadius( m_radiusCmd->GetNewDoubleValue( newValue ) ) )
+    {
+      G4cerr << "/det/radius: " << newValue << " is outside the world or narrower than one ring" << G4endl;
+      return;
+    }
+    else if ( command == m_ringWidthCmd && !m_detector->SetRingWidth( m_ringWidthCmd->GetNewDoubleValue( newValue ) ) )
+    {
+      G4cerr << "/det/ringWidth: " << newValue << " is wider than the radius" << G4endl;
+      return;
+    }
+    else if ( command == m_absorberThicknessCmd
+              && !m_detector->SetAbsorberThickness( m_absorberThicknessCmd->GetNewDoubleValue( newValue ) ) )
+    {
+      G4cerr << "/det/absorberThickness: " << newValue << " does not fit in the world" << G4endl;
+      return;
+    }
+    else if ( command == m_materialCmd && !m_detector->SetAbsorberMaterial( newValue ) )
+    {
+      G4cerr << "/det/material: unknown material " << newValue << G4endl;
+      return;
+    }
+    this->ReinitializeGeometry();
+    return;
+  }
+
+  G4String regionName, unit;
+  G4double value = 0.0;
+  std::istringstream( newValue ) >> regionName >> value >> unit;
+  value *= G4UIcommand::ValueOf( unit );
+
+  G4UserLimits* limits = m_detector->GetUserLimits( regionName );
+  if ( !limits ) return;
+
+  // Zero means no limit, which G4UserLimits spells DBL_MAX (or 0 for the energy)
+  if ( command == m_maxStepCmd ) limits->SetMaxAllowedStep( value > 0.0 ? value : DBL_MAX );
+  else if ( command == m_maxTrackLengthCmd ) limits->SetUserMaxTrackLength( value > 0.0 ? value : DBL_MAX );
+  else if ( command == m_minKineticEnergyCmd ) limits->SetUserMinEkine( value );
+}
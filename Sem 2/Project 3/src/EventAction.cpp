@@ -1,8 +1,15 @@
 #include "EventAction.h"
+#include "RunAction.h"
+#include "GeneratorAction.h"
+#include "Run.h"
+#include "RingCalorimeterSD.h"
 
-#include "g4csv.hh"
+#include "Output.h"
+#include "G4RunManager.hh"
+#include "G4SDManager.hh"
 
-EventAction::EventAction()
+EventAction::EventAction( RunAction* runAction, GeneratorAction* generatorAction )
+  : m_runAction( runAction ), m_generatorAction( generatorAction )
 {
 }
 
@@ -16,7 +23,38 @@ void EventAction::BeginOfEventAction( const G4Event* )
 
 void EventAction::EndOfEventAction( const G4Event* )
 {
-  // Finish the ntuple row
-  auto analysisManager = G4AnalysisManager::Instance();
-  analysisManager->AddNtupleRow( 0 );
+  // The calorimeter of this thread, made in ConstructSDandField
+  if ( !m_calorimeter )
+  {
+    m_calorimeter = static_cast< RingCalorimeterSD* >( G4SDManager::GetSDMpointer()->FindSensitiveDetector( "Detector" ) );
+  }
+  const auto& ringEnergies = m_calorimeter->GetRingEnergies();
+  const ScanGrid::Point& scanPoint = m_generatorAction->GetScanPoint();
+  const G4ParticleDefinition* particle = m_generatorAction->GetScanParticle();
+
+  // Add to the statistics of the run (and the scan histograms, if accumulating)
+  static_cast< Run* >( G4RunManager::GetRunManager()->GetNonConstCurrentRun() )
+    ->AddEvent( particle->GetParticleName(), scanPoint.energy, scanPoint.field, ringEnergies );
+
+  // Display the totals, only if asked for
+  if ( m_runAction->GetVerbose() >= 3 )
+  {
+    for ( std::size_t ring = 0; ring < ringEnergies.size(); ++ring )
+    {
+      G4cout << "Detector" << ring + 1 << " total energy = " << ringEnergies[ ring ] << G4endl;
+    }
+  }
+
+  // One row of the Energy table: event number, beam energy, field, a column per ring, then the particle
+  if ( !m_runAction->GetAccumulate() )
+  {
+    Output::FillEventColumn( scanPoint.number );
+    Output::FillColumn( 1, scanPoint.energy );
+    Output::FillColumn( 2, scanPoint.field );
+    Output::FillColumns( 3, ringEnergies.data(), ringEnergies.size() );
+    Output::FillColumn( G4int( 3 + ringEnergies.size() ), particle->GetPDGEncoding() );
+    Output::AddRow();
+  }
+
+  m_runAction->EventDone();
 }
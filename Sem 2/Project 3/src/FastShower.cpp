@@ -0,0 +1,41 @@
+#include "FastShower.h"
+
+#include "GFlashShowerModel.hh"
+#include "GFlashHomoShowerParameterisation.hh"
+#include "GFlashParticleBounds.hh"
+#include "GFlashHitMaker.hh"
+#include "G4Region.hh"
+
+FastShower::FastShower( G4Region* region, G4Material* material )
+{
+  // The model registers itself with the fast simulation manager of the region
+  m_model = new GFlashShowerModel( "FastShower", region );
+  m_parameterisation = new GFlashHomoShowerParameterisation( material );
+  m_model->SetParameterisation( *m_parameterisation );
+
+  // Electrons and positrons in the default energy range
+  m_particleBounds = new GFlashParticleBounds();
+  m_model->SetParticleBounds( *m_particleBounds );
+
+  // Energy spots, handed to the sensitive detector of the volume they are in
+  m_hitMaker = new GFlashHitMaker();
+  m_model->SetHitMaker( *m_hitMaker );
+
+  // Full simulation until asked for, and no containment test: the silicon is
+  // about one radiation length deep, so no shower would ever pass it
+  m_model->SetFlagParamOn( 0 );
+  m_model->SetFlagParticleContainment( 0 );
+}
+
+void FastShower::SetEnabled( G4bool enabled )
+{
+  m_model->SetFlagParamOn( enabled ? 1 : 0 );
+}
+
+FastShower::~FastShower()
+{
+  delete m_model;
+  delete m_parameterisation;
+  delete m_particleBounds;
+  delete m_hitMaker;
+}
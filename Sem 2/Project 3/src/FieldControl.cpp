@@ -0,0 +1,40 @@
+#include "FieldControl.h"
+#include "FieldControlMessenger.h"
+
+#include "G4UniformMagField.hh"
+#include "G4FieldManager.hh"
+#include "G4TransportationManager.hh"
+
+G4ThreadLocal FieldControl* FieldControl::m_instance = 0;
+
+FieldControl::FieldControl( const G4ThreeVector& value ) : m_value( value )
+{
+  // The global field manager of this thread, with a chord finder made once
+  // for this field object
+  m_field = new G4UniformMagField( value );
+  m_fieldManager = G4TransportationManager::GetTransportationManager()->GetFieldManager();
+  m_fieldManager->SetDetectorField( value.mag2() > 0.0 ? m_field : nullptr );
+  m_fieldManager->CreateChordFinder( m_field );
+
+  m_messenger = new FieldControlMessenger( this );
+  m_instance = this;
+}
+
+FieldControl::~FieldControl()
+{
+  if ( m_instance == this ) m_instance = 0;
+  delete m_messenger;
+  delete m_field;
+}
+
+void FieldControl::SetFieldValue( const G4ThreeVector& value )
+{
+  if ( value == m_value ) return;
+
+  // Just the value and the field pointer, nothing is rebuilt
+  G4bool wasOn = m_value.mag2() > 0.0;
+  G4bool isOn = value.mag2() > 0.0;
+  m_field->SetFieldValue( value );
+  if ( wasOn != isOn ) m_fieldManager->SetDetectorField( isOn ? m_field : nullptr );
+  m_value = value;
+}
@@ -0,0 +1,43 @@
+#include "FieldControlMessenger.h"
+#include "FieldControl.h"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWith3VectorAndUnit.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4SystemOfUnits.hh"
+
+FieldControlMessenger::FieldControlMessenger( FieldControl* fieldControl ) : G4UImessenger(), m_fieldControl( fieldControl )
+{
+  m_directory = new G4UIdirectory( "/globalField/" );
+  m_directory->SetGuidance( "The uniform magnetic field, changed in place" );
+
+  m_setValueCmd = new G4UIcmdWith3VectorAndUnit( "/globalField/setValue", this );
+  m_setValueCmd->SetGuidance( "Set the uniform magnetic field, until the next scan point changes it" );
+  m_setValueCmd->SetParameterName( "Bx", "By", "Bz", false );
+  m_setValueCmd->SetUnitCategory( "Magnetic flux density" );
+  m_setValueCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+
+  m_verboseCmd = new G4UIcmdWithAnInteger( "/globalField/verbose", this );
+  m_verboseCmd->SetGuidance( "1: print the field every time it is set with /globalField/setValue" );
+  m_verboseCmd->SetParameterName( "level", false );
+  m_verboseCmd->SetRange( "level >= 0" );
+  m_verboseCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+}
+
+FieldControlMessenger::~FieldControlMessenger()
+{
+  delete m_setValueCmd;
+  delete m_verboseCmd;
+  delete m_directory;
+}
+
+void FieldControlMessenger::SetNewValue( G4UIcommand* command, G4String newValue )
+{
+  if ( command == m_setValueCmd )
+  {
+    G4ThreeVector value = m_setValueCmd->GetNew3VectorValue( newValue );
+    m_fieldControl->SetFieldValue( value );
+    if ( m_fieldControl->GetVerboseLevel() > 0 ) G4cout << "Magnetic field set to " << value / tesla << " T" << G4endl;
+  }
+  else if ( command == m_verboseCmd ) m_fieldControl->SetVerboseLevel( m_verboseCmd->GetNewIntValue( newValue ) );
+}
@@ -1,20 +1,17 @@
 #include "GeneratorAction.h"
 
+#include "G4Event.hh"
 #include "G4ParticleTable.hh"
 #include "G4SystemOfUnits.hh"
-#include "g4csv.hh"
-#include <G4GlobalMagFieldMessenger.hh>
+#include "Randomize.hh"
+#include "FieldControl.h"
 
 
-GeneratorAction::GeneratorAction() : G4VUserPrimaryGeneratorAction()
+GeneratorAction::GeneratorAction( const ScanGrid* scanGrid ) : G4VUserPrimaryGeneratorAction(), m_scanGrid( scanGrid )
 {
   G4int nofParticles = 1;
-  // Amendment keeping track of number of particles fired to know when to
-  // increase energy and magnetic field values
-  runCounter = 0;
 
   m_particleGun = new G4ParticleGun( nofParticles );
-  m_fieldManager = new G4GlobalMagFieldMessenger(G4ThreeVector(0,0,0));
   // Default particle
   G4ParticleDefinition * particleDefinition = G4ParticleTable::GetParticleTable()->FindParticle( "e-" );
   m_particleGun->SetParticleDefinition( particleDefinition );
@@ -33,32 +30,27 @@ GeneratorAction::~GeneratorAction()
 // This function is called at the begining of event
 void GeneratorAction::GeneratePrimaries( G4Event* anEvent )
 {
+  // The scan point follows the event number, which is unique across all threads
+  m_scanPoint = m_scanGrid->GetPoint( anEvent->GetEventID() );
 
-  // Fire a particle
-  m_particleGun->GeneratePrimaryVertex( anEvent );
+  // Seed from the point rather than the order the events reach this thread,
+  // so a point always gives the same result
+  long seeds[ 3 ] = { 0, 0, 0 };
+  m_scanGrid->GetSeeds( m_scanPoint, seeds );
+  G4Random::setTheSeeds( seeds );
 
-  // Store truth information - first column
-  auto analysisManager = G4AnalysisManager::Instance();
-  G4double particleEnergy = m_particleGun->GetParticleEnergy();
-  double fieldStrength = m_fieldManager->GetFieldValue().getX();
-  analysisManager->FillNtupleDColumn( 0, 0, particleEnergy );
-  analysisManager->FillNtupleDColumn(0, 1, fieldStrength);
-
-  // After a number of particles fired, increase energy and mag field
-  runCounter++;
-  if(runCounter % 10 == 0)
-  {
-    // every 10, increase the magnetic field
-    m_fieldManager->SetFieldValue(G4ThreeVector(fieldStrength+=0.01*tesla,0,0));
+  // The field of this thread, changed in place (and only if it differs)
+  FieldControl::GetInstance()->SetFieldValue( G4ThreeVector( m_scanPoint.field, 0, 0 ) );
 
-  }
-  if(runCounter % 1000 == 0)
+  // The scanned particle, if the grid has any, otherwise whatever /gun/particle set
+  if ( !m_scanPoint.particle.empty() && m_particleGun->GetParticleDefinition()->GetParticleName() != m_scanPoint.particle )
   {
-    //every 100, increase the electric field and reset the magnetic field
-    m_particleGun->SetParticleEnergy(particleEnergy+=10.0*MeV);
-    m_fieldManager->SetFieldValue(G4ThreeVector(0,0,1E-9));
-    std::cout<<"Ran for "<<runCounter<<" events."<<std::endl;
+    G4ParticleDefinition* particle = G4ParticleTable::GetParticleTable()->FindParticle( m_scanPoint.particle );
+    if ( particle ) m_particleGun->SetParticleDefinition( particle );
+    else G4cerr << "GeneratorAction: unknown particle " << m_scanPoint.particle << G4endl;
   }
 
-
+  // Fire a particle
+  m_particleGun->SetParticleEnergy( m_scanPoint.energy );
+  m_particleGun->GeneratePrimaryVertex( anEvent );
 }
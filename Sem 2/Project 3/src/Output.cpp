@@ -0,0 +1,305 @@
+#include "Output.h"
+#include "ColumnWriter.h"
+
+#include "G4CsvAnalysisManager.hh"
+#include "G4RootAnalysisManager.hh"
+#include "G4XmlAnalysisManager.hh"
+#ifdef WITH_HDF5
+#include "G4Hdf5AnalysisManager.hh"
+#endif
+#include "G4Threading.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <utility>
+
+namespace
+{
+  // Set once by main(), before the worker threads start
+  Output::Format format = Output::CSV;
+  G4int compressionLevel = 1;
+  G4int chunkSize = 4096;
+
+  // The binary table of this thread, or whether its ntuple is booked, and its id
+  G4ThreadLocal ColumnWriter* columnWriter = 0;
+  G4ThreadLocal G4bool ntupleCreated = false;
+  G4ThreadLocal G4int ntupleId = 0;
+
+  // The analysis manager of this thread, for the other formats
+  G4VAnalysisManager* GetAnalysisManager()
+  {
+    switch ( format )
+    {
+      case Output::ROOT: return G4RootAnalysisManager::Instance();
+      case Output::XML: return G4XmlAnalysisManager::Instance();
+#ifdef WITH_HDF5
+      case Output::HDF5: return G4Hdf5AnalysisManager::Instance();
+#endif
+      default: return G4CsvAnalysisManager::Instance();
+    }
+  }
+
+  // The analysis manager, with the Energy ntuple booked on the first call
+  G4VAnalysisManager* BookNtuple()
+  {
+    auto analysisManager = GetAnalysisManager();
+    if ( !ntupleCreated )
+    {
+      // ROOT and HDF5 compress, and ROOT joins the worker ntuples itself into one file
+      if ( format == Output::ROOT || format == Output::HDF5 ) analysisManager->SetCompressionLevel( compressionLevel );
+      if ( format == Output::ROOT ) G4RootAnalysisManager::Instance()->SetNtupleMerging( true );
+      ntupleId = analysisManager->CreateNtuple( "Energy", "Deposited energy" );
+      ntupleCreated = true;
+    }
+    return analysisManager;
+  }
+
+  G4String GetFileName( const G4String& outputName, const G4String& suffix )
+  {
+    switch ( format )
+    {
+      case Output::ROOT: return outputName + suffix + ".root";
+      case Output::HDF5: return outputName + suffix + ".hdf5";
+      case Output::XML: return outputName + "_nt_Energy" + suffix + ".xml";
+      case Output::Binary: return outputName + "_nt_Energy" + suffix + ".bin";
+      default: return outputName + "_nt_Energy" + suffix + ".csv";
+    }
+  }
+
+  // Join tables with the same columns into one file, with the rows sorted by
+  // the event number in the first column, deleting the inputs once it is
+  // complete; false, with the inputs kept, if it failed
+  // Every event is seeded from its point and its number within it, so the
+  // joined file is the same whichever thread or chunk ran each event
+  G4bool JoinFiles( const std::vector< G4String >& inputNames, const G4String& outputFile )
+  {
+    if ( format == Output::Binary ) return ColumnWriter::Merge( inputNames, outputFile, compressionLevel, chunkSize );
+    if ( format != Output::CSV ) return true;
+
+    std::string header;
+    std::vector< std::pair< G4long, std::string > > rows;
+    G4bool failed = false;
+    std::vector< G4String > joined;
+    for ( const auto& fileName : inputNames )
+    {
+      std::ifstream input( fileName );
+      if ( !input ) continue;
+
+      // Column descriptions start with #, and are the same in every file
+      G4bool first = joined.empty();
+      std::string line;
+      while ( std::getline( input, line ) )
+      {
+        if ( line.empty() ) continue;
+        if ( line[0] == '#' )
+        {
+          if ( first ) header += line + "\n";
+        }
+        else rows.emplace_back( std::atol( line.c_str() ), line );
+      }
+      if ( input.bad() ) failed = true;
+      joined.push_back( fileName );
+    }
+
+    std::stable_sort( rows.begin(), rows.end(),
+                      []( const std::pair< G4long, std::string >& a, const std::pair< G4long, std::string >& b )
+                      { return a.first < b.first; } );
+
+    std::ofstream output( outputFile );
+    output << header;
+    for ( const auto& row : rows ) output << row.second << "\n";
+    if ( failed ) output.setstate( std::ios::failbit );
+    output.close();
+    if ( !output )
+    {
+      G4cerr << "Output: could not write " << outputFile << ", keeping its inputs" << G4endl;
+      return false;
+    }
+    for ( const auto& fileName : joined ) std::remove( fileName.c_str() );
+    return true;
+  }
+
+  // Size of a file in bytes, 0 if it does not exist
+  G4long FileSize( const G4String& fileName )
+  {
+    std::ifstream file( fileName, std::ios::binary | std::ios::ate );
+    if ( !file ) return 0;
+    return file.tellg();
+  }
+}
+
+G4bool Output::SetFormat( const G4String& name )
+{
+  if ( name == "csv" ) format = CSV;
+  else if ( name == "root" ) format = ROOT;
+  else if ( name == "xml" ) format = XML;
+  else if ( name == "bin" ) format = Binary;
+#ifdef WITH_HDF5
+  else if ( name == "hdf5" ) format = HDF5;
+#endif
+  else return false;
+  return true;
+}
+
+Output::Format Output::GetFormat()
+{
+  return format;
+}
+
+void Output::SetCompressionLevel( G4int level )
+{
+  compressionLevel = level;
+}
+
+void Output::SetChunkSize( G4int rows )
+{
+  chunkSize = rows;
+}
+
+// The binary table stores every column as doubles, exact for event numbers below 2^53
+void Output::CreateEventColumn( const G4String& name )
+{
+  if ( format == Binary ) CreateColumn( name );
+  else BookNtuple()->CreateNtupleIColumn( name );
+}
+
+void Output::CreateColumn( const G4String& name )
+{
+  if ( format == Binary )
+  {
+    if ( !columnWriter ) columnWriter = new ColumnWriter();
+    columnWriter->AddColumn( name );
+    return;
+  }
+  BookNtuple()->CreateNtupleDColumn( name );
+}
+
+void Output::FinishTable()
+{
+  if ( format != Binary ) GetAnalysisManager()->FinishNtuple( ntupleId );
+}
+
+void Output::ResetTable()
+{
+  if ( format == Binary )
+  {
+    delete columnWriter;
+    columnWriter = 0;
+    return;
+  }
+  if ( !ntupleCreated ) return;
+
+  // Ntuples cannot be deleted, but inactive ones are not written
+  auto analysisManager = GetAnalysisManager();
+  analysisManager->SetActivation( true );
+  analysisManager->SetNtupleActivation( ntupleId, false );
+  ntupleCreated = false;
+}
+
+void Output::FillEventColumn( G4long event )
+{
+  if ( format == Binary ) columnWriter->Fill( 0, G4double( event ) );
+  else GetAnalysisManager()->FillNtupleIColumn( ntupleId, 0, G4int( event ) );
+}
+
+void Output::FillColumn( G4int column, G4double value )
+{
+  if ( format == Binary ) columnWriter->Fill( column, value );
+  else GetAnalysisManager()->FillNtupleDColumn( ntupleId, column, value );
+}
+
+void Output::FillColumns( G4int firstColumn, const G4double* values, std::size_t n )
+{
+  if ( format == Binary )
+  {
+    columnWriter->Fill( firstColumn, values, n );
+    return;
+  }
+  auto analysisManager = GetAnalysisManager();
+  for ( std::size_t i = 0; i < n; ++i ) analysisManager->FillNtupleDColumn( ntupleId, firstColumn + i, values[ i ] );
+}
+
+void Output::AddRow()
+{
+  if ( format == Binary ) columnWriter->AddRow();
+  else GetAnalysisManager()->AddNtupleRow( ntupleId );
+}
+
+void Output::OpenFile( const G4String& outputName )
+{
+  if ( format == Binary )
+  {
+    // Each worker writes its own file, the master joins them
+    if ( G4Threading::IsMultithreadedApplication() && G4Threading::IsMasterThread() ) return;
+    G4String suffix = G4Threading::IsWorkerThread() ? "_t" + std::to_string( G4Threading::G4GetThreadId() ) : "";
+    columnWriter->Open( GetFileName( outputName, suffix ), compressionLevel, chunkSize );
+  }
+  // The extension follows the format
+  else GetAnalysisManager()->OpenFile( outputName );
+}
+
+void Output::CloseFile()
+{
+  if ( format == Binary ) columnWriter->Close();
+  else
+  {
+    GetAnalysisManager()->Write();
+    GetAnalysisManager()->CloseFile();
+  }
+}
+
+void Output::Delete()
+{
+  if ( format == Binary )
+  {
+    delete columnWriter;
+    columnWriter = 0;
+  }
+  else
+  {
+    delete GetAnalysisManager();
+    ntupleCreated = false;
+  }
+}
+
+// Join the files written by each worker thread (<output>_nt_Energy_t<i>)
+// into the single file a sequential run would have written, row for row
+void Output::MergeWorkerFiles( const G4String& outputName, G4int nThreads )
+{
+  std::vector< G4String > inputNames;
+  for ( G4int thread = 0; thread < nThreads; ++thread )
+  {
+    inputNames.push_back( GetFileName( outputName, "_t" + std::to_string( thread ) ) );
+  }
+  // ROOT merges by itself, XML and HDF5 stay one file per thread
+  JoinFiles( inputNames, GetFileName( outputName, "" ) );
+}
+
+// The rows are sorted again, so a scan gives the same file whether or not it
+// was checkpointed and resumed, with any number of threads; ROOT, XML and
+// HDF5 keep a file per chunk
+G4bool Output::JoinChunks( const std::vector< G4String >& chunkNames, const G4String& outputName )
+{
+  std::vector< G4String > inputNames;
+  for ( const auto& chunkName : chunkNames )
+  {
+    // Accumulating scans write no table
+    G4String fileName = GetFileName( chunkName, "" );
+    if ( std::ifstream( fileName ) ) inputNames.push_back( fileName );
+  }
+  return inputNames.empty() || JoinFiles( inputNames, GetFileName( outputName, "" ) );
+}
+
+G4long Output::GetOutputSize( const G4String& outputName, G4int nThreads )
+{
+  // The joined file, then whatever the threads left behind
+  G4long size = FileSize( GetFileName( outputName, "" ) );
+  for ( G4int thread = 0; thread < nThreads; ++thread )
+  {
+    size += FileSize( GetFileName( outputName, "_t" + std::to_string( thread ) ) );
+  }
+  return size;
+}
@@ -0,0 +1,73 @@
+#include "RingCalorimeterSD.h"
+
+#include "G4Step.hh"
+#include "G4GFlashSpot.hh"
+#include "G4VTouchable.hh"
+#include "G4NavigationHistory.hh"
+
+#include <algorithm>
+
+RingCalorimeterSD::RingCalorimeterSD( const G4String& name )
+  : G4VSensitiveDetector( name ) // Run the constructor of the parent class
+{
+}
+
+RingCalorimeterSD::~RingCalorimeterSD()
+{
+}
+
+void RingCalorimeterSD::SetRings( G4int nRings, G4double ringWidth, G4bool binByRadius )
+{
+  m_ringEnergies.assign( nRings, 0.0 );
+  m_ringWidth = ringWidth;
+  m_binByRadius = binByRadius;
+}
+
+// At the start of the event, zero the energy counters
+void RingCalorimeterSD::Initialize( G4HCofThisEvent* )
+{
+  std::fill( m_ringEnergies.begin(), m_ringEnergies.end(), 0.0 );
+}
+
+// The ring of a deposit at a global position in the disk of touchable
+G4int RingCalorimeterSD::GetRadiusBin( const G4VTouchable* touchable, const G4ThreeVector& position ) const
+{
+  G4ThreeVector local = touchable->GetHistory()->GetTopTransform().TransformPoint( position );
+  return std::min( G4int( local.perp() / m_ringWidth ), G4int( m_ringEnergies.size() ) - 1 );
+}
+
+// Analyse anything that hits the detector
+G4bool RingCalorimeterSD::ProcessHits( G4Step* step, G4TouchableHistory* )
+{
+  // Get the energy deposited by this hit
+  G4double edep = step->GetTotalEnergyDeposit();
+  if ( edep == 0.0 ) return false;
+
+  // Add to the total energy in the ring it was deposited in
+  // (the copy number, since the pre-step radius is ambiguous on a ring boundary,
+  // or the middle of the step in the single disk, which has no ring boundaries)
+  const G4VTouchable* touchable = step->GetPreStepPoint()->GetTouchable();
+  G4int ring = 0;
+  if ( m_binByRadius )
+  {
+    G4ThreeVector middle = 0.5 * ( step->GetPreStepPoint()->GetPosition() + step->GetPostStepPoint()->GetPosition() );
+    ring = this->GetRadiusBin( touchable, middle );
+  }
+  else ring = touchable->GetCopyNumber();
+  m_ringEnergies[ ring ] += edep;
+
+  return true;
+}
+
+// The same for an energy spot of a parameterised shower
+G4bool RingCalorimeterSD::ProcessHits( G4GFlashSpot* spot, G4TouchableHistory* )
+{
+  G4double edep = spot->GetEnergySpot()->GetEnergy();
+  if ( edep == 0.0 ) return false;
+
+  const G4VTouchable* touchable = spot->GetTouchableHandle()();
+  G4int ring = m_binByRadius ? this->GetRadiusBin( touchable, spot->GetPosition() ) : touchable->GetCopyNumber();
+  m_ringEnergies[ ring ] += edep;
+
+  return true;
+}
@@ -0,0 +1,88 @@
+#include "Run.h"
+
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+namespace
+{
+  // Mean, RMS and maximum of a column of the summary
+  void PrintLine( const G4String& name, G4int n, G4double sum, G4double sum2, G4double max )
+  {
+    G4double mean = sum / n;
+    G4double rms = std::sqrt( std::max( sum2 / n - mean * mean, 0.0 ) );
+    G4cout << std::setw( 12 ) << name
+           << std::setw( 12 ) << mean / MeV
+           << std::setw( 12 ) << rms / MeV
+           << std::setw( 12 ) << max / MeV << G4endl;
+  }
+}
+
+Run::Run( G4int nRings, ScanHistograms* scanHistograms )
+  : G4Run(), m_scan( scanHistograms ), m_nRings( nRings ),
+    m_sum( nRings, 0.0 ), m_sum2( nRings, 0.0 ), m_max( nRings, 0.0 )
+{
+}
+
+Run::~Run()
+{
+  delete m_scan;
+}
+
+void Run::AddEvent( const G4String& particle, G4double beamEnergy, G4double field,
+                    const std::vector< G4double >& ringEnergies )
+{
+  if ( m_scan ) m_scan->AddEvent( particle, beamEnergy, field, ringEnergies );
+
+  ++m_nEvents;
+  G4double total = 0.0;
+  for ( G4int ring = 0; ring < m_nRings; ++ring )
+  {
+    G4double energy = ringEnergies[ ring ];
+    m_sum[ ring ] += energy;
+    m_sum2[ ring ] += energy * energy;
+    m_max[ ring ] = std::max( m_max[ ring ], energy );
+    total += energy;
+  }
+  m_totalSum += total;
+  m_totalSum2 += total * total;
+  m_totalMax = std::max( m_totalMax, total );
+}
+
+// Called on the master with the run of each worker
+void Run::Merge( const G4Run* run )
+{
+  const Run* workerRun = static_cast< const Run* >( run );
+  m_nEvents += workerRun->m_nEvents;
+  for ( G4int ring = 0; ring < m_nRings; ++ring )
+  {
+    m_sum[ ring ] += workerRun->m_sum[ ring ];
+    m_sum2[ ring ] += workerRun->m_sum2[ ring ];
+    m_max[ ring ] = std::max( m_max[ ring ], workerRun->m_max[ ring ] );
+  }
+  m_totalSum += workerRun->m_totalSum;
+  m_totalSum2 += workerRun->m_totalSum2;
+  m_totalMax = std::max( m_totalMax, workerRun->m_totalMax );
+  if ( m_scan && workerRun->m_scan ) m_scan->Merge( *workerRun->m_scan );
+
+  G4Run::Merge( run );
+}
+
+void Run::PrintSummary( G4int verbose ) const
+{
+  if ( verbose < 1 || m_nEvents == 0 ) return;
+
+  G4cout << "Run " << this->GetRunID() << ": energy deposited per event in " << m_nEvents << " events" << G4endl;
+  G4cout << std::setw( 12 ) << "" << std::setw( 12 ) << "mean [MeV]" << std::setw( 12 ) << "rms [MeV]"
+         << std::setw( 12 ) << "max [MeV]" << G4endl;
+  if ( verbose >= 2 )
+  {
+    for ( G4int ring = 0; ring < m_nRings; ++ring )
+    {
+      PrintLine( "Detector" + std::to_string( ring + 1 ), m_nEvents, m_sum[ ring ], m_sum2[ ring ], m_max[ ring ] );
+    }
+  }
+  PrintLine( "All rings", m_nEvents, m_totalSum, m_totalSum2, m_totalMax );
+}
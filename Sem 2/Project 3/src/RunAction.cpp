@@ -1,48 +1,174 @@
 #include "RunAction.h"
+#include "RunActionMessenger.h"
+#include "Run.h"
 
-#include "g4csv.hh"
-#include "Consts.h"
+#include "DetectorConstruction.h"
+#include "ScanGrid.h"
 
-RunAction::RunAction() : G4UserRunAction()
+#include "Output.h"
+
+#ifdef G4MULTITHREADED
+#include "G4MTRunManager.hh"
+#endif
+
+namespace
+{
+  // The detector is shared by all threads, and only changes between runs
+  G4int GetNumberOfRings()
+  {
+    auto detector = static_cast< const DetectorConstruction* >( G4RunManager::GetRunManager()->GetUserDetectorConstruction() );
+    return detector->GetNumberOfRings();
+  }
+}
+
+RunAction::RunAction( const ScanGrid* scanGrid ) : G4UserRunAction(), m_scanGrid( scanGrid )
+{
+  m_messenger = new RunActionMessenger( this );
+}
+
+// Add a table for energy deposits, in the format chosen in main(), replacing
+// the table of an earlier run with a different number of rings
+void RunAction::BookTable( G4int nRings )
 {
-  
-  // Create analysis manager
-  auto analysisManager = G4AnalysisManager::Instance();
+  if ( m_tableRings > 0 ) Output::ResetTable();
 
-  // Add an ntuple for energy deposits (ntuple id 0)
-  analysisManager->CreateNtuple( "Energy", "Deposited energy");
-  analysisManager->CreateNtupleDColumn( "Generated" );
-  analysisManager->CreateNtupleDColumn("Magnetic field");
+  // Number of the event in the scan, which the joined files are sorted by
+  Output::CreateEventColumn( "EventNumber" );
+  Output::CreateColumn( "Generated" );
+  Output::CreateColumn("Magnetic field");
   // Add a column for each layer of the detector
-  int numLayers = (int) radius / detectorRingWidth;
-  for(int layer = 1; layer<=numLayers; layer++)
+  for(int layer = 1; layer<=nRings; layer++)
   {
-    analysisManager->CreateNtupleDColumn("Detector"+std::to_string(layer));
+    Output::CreateColumn("Detector"+std::to_string(layer));
   }
-  analysisManager->FinishNtuple();
+  // PDG code of the beam particle
+  Output::CreateColumn( "Particle" );
+  Output::FinishTable();
+
+  m_tableRings = nRings;
 }
 
 RunAction::~RunAction()
 {
+  delete m_messenger;
+  delete m_scanTotal;
+
   // Delete analysis manager
-  delete G4AnalysisManager::Instance();
+  Output::Delete();
+}
+
+// Each thread keeps its own statistics, which the master joins
+G4Run* RunAction::GenerateRun()
+{
+  G4int nRings = GetNumberOfRings();
+  if ( m_accumulate ) return new Run( nRings, new ScanHistograms( nRings, m_depositBins, m_maxDeposit ) );
+  return new Run( nRings );
 }
 
 void RunAction::BeginOfRunAction( const G4Run* )
 {
-  // Get analysis manager
-  auto analysisManager = G4AnalysisManager::Instance();
+  // The geometry may have been rebuilt since the last run
+  G4int nRings = GetNumberOfRings();
+  if ( nRings != m_tableRings ) this->BookTable( nRings );
+
+  // Open an output file (the extension follows the format)
+  if ( !m_accumulate ) Output::OpenFile( m_scanGrid->GetOutputName() );
+
+  m_nSteps = 0;
+  m_nEvents = 0;
+  m_runStart = std::chrono::steady_clock::now();
+}
+
+void RunAction::EventDone()
+{
+  ++m_nEvents;
+  if ( m_verbose < 1 || m_printEvery <= 0 || m_nEvents % m_printEvery != 0 ) return;
 
-  // Open an output file
-  analysisManager->OpenFile( "output.csv" );
+  G4double runTime = std::chrono::duration< G4double >( std::chrono::steady_clock::now() - m_runStart ).count();
+  G4cout << "Ran for " << m_nEvents << " events, " << m_nEvents / runTime << " events per second" << G4endl;
 }
 
-void RunAction::EndOfRunAction( const G4Run* )
+void RunAction::EndOfRunAction( const G4Run* run )
 {
-  // Get analysis manager
-  auto analysisManager = G4AnalysisManager::Instance();
+  // Energy in the rings, for the whole job
+  if ( this->IsMaster() ) static_cast< const Run* >( run )->PrintSummary( m_verbose );
+
+  // Throughput of this thread, or of the whole job on the master (which takes no steps)
+  G4int nEvents = run->GetNumberOfEvent();
+  G4double runTime = std::chrono::duration< G4double >( std::chrono::steady_clock::now() - m_runStart ).count();
+  if ( m_verbose >= 1 && nEvents > 0 && runTime > 0.0 )
+  {
+    G4cout << "RunAction: " << nEvents << " events in " << runTime << " s, "
+           << nEvents / runTime << " events per second";
+    if ( m_nSteps > 0 )
+    {
+      G4cout << ", " << G4double( m_nSteps ) / nEvents << " steps per event, "
+             << m_nSteps / runTime << " steps per second";
+    }
+    G4cout << G4endl;
+  }
+
+  // Only the master has the whole scan to write, and there is no Energy table
+  if ( m_accumulate )
+  {
+    if ( this->IsMaster() ) this->WriteScan( static_cast< const Run* >( run )->GetScanHistograms() );
+    return;
+  }
 
   // Save output data
-  analysisManager->Write();
-  analysisManager->CloseFile();
+  auto writeStart = std::chrono::steady_clock::now();
+  Output::CloseFile();
+  G4double writeTime = std::chrono::duration< G4double >( std::chrono::steady_clock::now() - writeStart ).count();
+  if ( m_verbose >= 1 ) G4cout << "RunAction: output written in " << writeTime << " s" << G4endl;
+
+  // In multithreaded mode the master runs this after all the workers have
+  // closed their files, so they can be joined here
+  G4int nThreads = 0;
+#ifdef G4MULTITHREADED
+  auto mtRunManager = dynamic_cast< G4MTRunManager* >( G4RunManager::GetRunManager() );
+  if ( mtRunManager ) nThreads = mtRunManager->GetNumberOfThreads();
+  if ( this->IsMaster() && mtRunManager ) Output::MergeWorkerFiles( m_scanGrid->GetOutputName(), nThreads );
+#endif
+
+  // Size of everything written
+  if ( this->IsMaster() && m_verbose >= 1 )
+  {
+    G4cout << "RunAction: " << Output::GetOutputSize( m_scanGrid->GetOutputName(), nThreads ) << " bytes of output" << G4endl;
+  }
+}
+
+// The scan histograms of a checkpointed scan are added up over its chunks, so
+// output_scan.csv always holds the whole scan so far, and the exact sums are
+// saved for a job that resumes it
+void RunAction::WriteScan( const ScanHistograms* runScan )
+{
+  auto writeStart = std::chrono::steady_clock::now();
+  G4int chunk = m_scanGrid->GetChunk();
+  const ScanHistograms* scan = runScan;
+  if ( chunk >= 0 )
+  {
+    if ( chunk == 0 || !m_scanTotal )
+    {
+      delete m_scanTotal;
+      m_scanTotal = new ScanHistograms( GetNumberOfRings(), m_depositBins, m_maxDeposit );
+      // A resumed job carries on from the chunks already done
+      if ( chunk > 0 && !m_scanTotal->Load( ScanGrid::GetScanStateName( chunk ), chunk ) )
+      {
+        G4cerr << "RunAction: ERROR the scan histograms of the first " << chunk << " chunks ("
+               << ScanGrid::GetScanStateName( chunk ) << ") cannot be read, "
+               << ScanGrid::GetOutputName( -1 ) << "_scan.csv only covers the chunks of this job" << G4endl;
+      }
+    }
+    m_scanTotal->Merge( *runScan );
+    // Only kept by SaveCheckpoint, once the chunk is recorded as done
+    m_scanTotal->Save( ScanGrid::GetScanStateName( -1 ), chunk + 1 );
+    scan = m_scanTotal;
+  }
+
+  G4long outputSize = scan->Write( ScanGrid::GetOutputName( -1 ) );
+  G4double writeTime = std::chrono::duration< G4double >( std::chrono::steady_clock::now() - writeStart ).count();
+  if ( m_verbose >= 1 )
+  {
+    G4cout << "RunAction: scan histograms written in " << writeTime << " s, " << outputSize << " bytes of output" << G4endl;
+  }
 }
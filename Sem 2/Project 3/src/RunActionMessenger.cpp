@@ -0,0 +1,72 @@
+#include "RunActionMessenger.h"
+#include "RunAction.h"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+RunActionMessenger::RunActionMessenger( RunAction* runAction ) : G4UImessenger(), m_runAction( runAction )
+{
+  m_directory = new G4UIdirectory( "/summary/" );
+  m_directory->SetGuidance( "What is printed about the energy in the rings" );
+
+  m_verboseCmd = new G4UIcmdWithAnInteger( "/summary/verbose", this );
+  m_verboseCmd->SetGuidance( "0: nothing" );
+  m_verboseCmd->SetGuidance( "1: progress, and the total energy at the end of the run (default)" );
+  m_verboseCmd->SetGuidance( "2: also the mean, RMS and maximum for each ring" );
+  m_verboseCmd->SetGuidance( "3: also the energy in each ring for every event (slow)" );
+  m_verboseCmd->SetParameterName( "level", false );
+  m_verboseCmd->SetRange( "level >= 0 && level <= 3" );
+  m_verboseCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+
+  m_printEveryCmd = new G4UIcmdWithAnInteger( "/summary/printEvery", this );
+  m_printEveryCmd->SetGuidance( "Print progress and throughput every this many events of each thread, 0 for never" );
+  m_printEveryCmd->SetParameterName( "events", false );
+  m_printEveryCmd->SetRange( "events >= 0" );
+  m_printEveryCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+
+  m_histoDirectory = new G4UIdirectory( "/histo/" );
+  m_histoDirectory->SetGuidance( "Reduce the scan in memory instead of writing a row per event" );
+
+  m_accumulateCmd = new G4UIcmdWithABool( "/histo/accumulate", this );
+  m_accumulateCmd->SetGuidance( "Fill the mean and RMS of each ring for every (energy, field) scan point, and" );
+  m_accumulateCmd->SetGuidance( "a histogram of ring against deposited energy for every beam energy." );
+  m_accumulateCmd->SetGuidance( "Only these are written, to output_scan.csv and output_profile.csv, at the end of the run." );
+  m_accumulateCmd->SetParameterName( "accumulate", true );
+  m_accumulateCmd->SetDefaultValue( true );
+  m_accumulateCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+
+  m_depositBinsCmd = new G4UIcmdWithAnInteger( "/histo/depositBins", this );
+  m_depositBinsCmd->SetGuidance( "Number of deposited energy bins per ring, from 0 to /histo/maxDeposit" );
+  m_depositBinsCmd->SetParameterName( "bins", false );
+  m_depositBinsCmd->SetRange( "bins > 0" );
+  m_depositBinsCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+
+  m_maxDepositCmd = new G4UIcmdWithADoubleAndUnit( "/histo/maxDeposit", this );
+  m_maxDepositCmd->SetGuidance( "Upper edge of the deposited energy histograms, anything above goes in the overflow bin" );
+  m_maxDepositCmd->SetParameterName( "energy", false );
+  m_maxDepositCmd->SetRange( "energy > 0" );
+  m_maxDepositCmd->SetUnitCategory( "Energy" );
+  m_maxDepositCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+}
+
+RunActionMessenger::~RunActionMessenger()
+{
+  delete m_verboseCmd;
+  delete m_printEveryCmd;
+  delete m_directory;
+  delete m_accumulateCmd;
+  delete m_depositBinsCmd;
+  delete m_maxDepositCmd;
+  delete m_histoDirectory;
+}
+
+void RunActionMessenger::SetNewValue( G4UIcommand* command, G4String newValue )
+{
+  if ( command == m_verboseCmd ) m_runAction->SetVerbose( m_verboseCmd->GetNewIntValue( newValue ) );
+  else if ( command == m_printEveryCmd ) m_runAction->SetPrintEvery( m_printEveryCmd->GetNewIntValue( newValue ) );
+  else if ( command == m_accumulateCmd ) m_runAction->SetAccumulate( m_accumulateCmd->GetNewBoolValue( newValue ) );
+  else if ( command == m_depositBinsCmd ) m_runAction->SetDepositBins( m_depositBinsCmd->GetNewIntValue( newValue ) );
+  else if ( command == m_maxDepositCmd ) m_runAction->SetMaxDeposit( m_maxDepositCmd->GetNewDoubleValue( newValue ) );
+}
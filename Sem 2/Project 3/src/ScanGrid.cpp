@@ -0,0 +1,200 @@
+#include "ScanGrid.h"
+#include "ScanGridMessenger.h"
+
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace
+{
+  const char* checkpointFile = "output.checkpoint";
+  const char* engineFile = "output.rndm";
+
+  // splitmix64, to turn (seed, point, event) into well spread engine seeds
+  unsigned long long Mix( unsigned long long x )
+  {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = ( x ^ ( x >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+    x = ( x ^ ( x >> 27 ) ) * 0x94d049bb133111ebULL;
+    return x ^ ( x >> 31 );
+  }
+}
+
+// The default is the scan this program always did: 200 to 1190 MeV in
+// steps of 10 MeV, 0 to 0.99 T in steps of 0.01 T, 10 events per point
+ScanGrid::ScanGrid()
+{
+  m_energies = MakeRange( 200.0*MeV, 1190.0*MeV, 10.0*MeV );
+  m_fields = MakeRange( 0.0, 0.99*tesla, 0.01*tesla );
+  m_messenger = new ScanGridMessenger( this );
+}
+
+ScanGrid::~ScanGrid()
+{
+  delete m_messenger;
+}
+
+std::vector< G4double > ScanGrid::MakeRange( G4double start, G4double stop, G4double step )
+{
+  std::vector< G4double > values;
+  if ( step <= 0.0 || stop < start ) return { start };
+  // Half a step of slack, so the stop value survives rounding
+  G4int n = G4int( ( stop - start ) / step + 0.5 ) + 1;
+  for ( G4int i = 0; i < n; ++i ) values.push_back( start + i * step );
+  return values;
+}
+
+void ScanGrid::SetEnergies( G4double start, G4double stop, G4double step )
+{
+  m_energies = MakeRange( start, stop, step );
+}
+
+void ScanGrid::SetFields( G4double start, G4double stop, G4double step )
+{
+  m_fields = MakeRange( start, stop, step );
+}
+
+void ScanGrid::SetParticles( const G4String& names )
+{
+  m_particles.clear();
+  std::istringstream stream( names );
+  G4String name;
+  while ( stream >> name ) m_particles.push_back( name );
+}
+
+G4String ScanGrid::GetOutputName() const
+{
+  return GetOutputName( m_chunk );
+}
+
+G4String ScanGrid::GetOutputName( G4int chunk )
+{
+  if ( chunk < 0 ) return "output";
+  return "output_c" + std::to_string( chunk );
+}
+
+G4int ScanGrid::GetNumberOfPoints() const
+{
+  G4int nParticles = m_particles.empty() ? 1 : G4int( m_particles.size() );
+  return nParticles * G4int( m_energies.size() * m_fields.size() );
+}
+
+ScanGrid::Point ScanGrid::GetPoint( G4int eventID ) const
+{
+  Point point;
+  G4long scanEvent = m_firstEvent + eventID;
+  point.index = G4int( ( scanEvent / m_eventsPerPoint ) % this->GetNumberOfPoints() );
+  point.event = G4int( scanEvent % m_eventsPerPoint );
+  point.number = scanEvent;
+
+  G4int nFields = m_fields.size();
+  G4int nEnergies = m_energies.size();
+  point.field = m_fields[ point.index % nFields ];
+  point.energy = m_energies[ ( point.index / nFields ) % nEnergies ];
+  if ( !m_particles.empty() ) point.particle = m_particles[ point.index / ( nFields * nEnergies ) ];
+  return point;
+}
+
+void ScanGrid::GetSeeds( const Point& point, long seeds[ 2 ] ) const
+{
+  unsigned long long key = Mix( Mix( Mix( m_seed ) ^ point.index ) ^ point.event );
+  // RanecuEngine wants positive seeds below 2^31
+  seeds[ 0 ] = long( key % 2147483562ULL ) + 1;
+  seeds[ 1 ] = long( Mix( key ) % 2147483398ULL ) + 1;
+}
+
+void ScanGrid::Print() const
+{
+  G4cout << "Scan: " << this->GetNumberOfPoints() << " points of " << m_eventsPerPoint << " events, "
+         << m_energies.size() << " energies from " << m_energies.front() / MeV << " to " << m_energies.back() / MeV << " MeV, "
+         << m_fields.size() << " fields from " << m_fields.front() / tesla << " to " << m_fields.back() / tesla << " T";
+  if ( !m_particles.empty() ) G4cout << ", " << m_particles.size() << " particles";
+  G4cout << ", seed " << m_seed;
+  if ( m_checkpointEvery > 0 ) G4cout << ", checkpoint every " << m_checkpointEvery << " events";
+  G4cout << G4endl;
+}
+
+G4String ScanGrid::GetScanStateName( G4int nChunks )
+{
+  if ( nChunks < 0 ) return GetOutputName( -1 ) + "_scan.state.tmp";
+  return GetOutputName( -1 ) + "_scan_" + std::to_string( nChunks ) + ".state";
+}
+
+// Every value of the grid, to the last bit, so a macro changed to another
+// grid of the same size does not carry on from this one
+G4String ScanGrid::DescribeSlice( G4long first, G4long count ) const
+{
+  std::ostringstream text;
+  text << std::setprecision( std::numeric_limits< G4double >::max_digits10 );
+  text << m_seed << " " << m_eventsPerPoint << " " << m_checkpointEvery << " " << first << " " << count << "\n";
+  text << m_particles.size();
+  for ( const auto& particle : m_particles ) text << " " << particle;
+  text << "\n" << m_energies.size();
+  for ( G4double energy : m_energies ) text << " " << energy;
+  text << "\n" << m_fields.size();
+  for ( G4double field : m_fields ) text << " " << field;
+  text << "\n";
+  return text.str();
+}
+
+// Written after each chunk, once its output is complete, so the file always
+// describes finished work. The scan histograms of the chunk are moved to
+// their final name first, and those of the chunk before only removed after,
+// so whenever the job stops the checkpoint has its matching histograms
+void ScanGrid::SaveCheckpoint( G4long first, G4long count, G4long eventsDone, G4int nChunks ) const
+{
+  G4Random::saveEngineStatus( engineFile );
+
+  G4bool haveState = std::rename( GetScanStateName( -1 ).c_str(), GetScanStateName( nChunks ).c_str() ) == 0;
+
+  // Write then rename, so a preemption mid-write leaves the last checkpoint
+  G4String temporary = G4String( checkpointFile ) + ".tmp";
+  {
+    std::ofstream file( temporary );
+    file << this->DescribeSlice( first, count ) << eventsDone << " " << nChunks << " " << haveState << "\n";
+  }
+  std::rename( temporary.c_str(), checkpointFile );
+
+  if ( nChunks > 0 ) std::remove( GetScanStateName( nChunks - 1 ).c_str() );
+}
+
+G4bool ScanGrid::LoadCheckpoint( G4long first, G4long count, G4long& eventsDone, G4int& nChunks ) const
+{
+  std::ifstream file( checkpointFile );
+  if ( !file ) return false;
+
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  G4String description = this->DescribeSlice( first, count );
+  if ( contents.str().compare( 0, description.size(), description ) != 0 )
+  {
+    G4cout << "The checkpoint is for another slice, grid or settings, starting again" << G4endl;
+    return false;
+  }
+
+  G4bool haveState = false;
+  std::istringstream progress( contents.str().substr( description.size() ) );
+  progress >> eventsDone >> nChunks >> haveState;
+  if ( !progress ) return false;
+  if ( haveState && !std::ifstream( GetScanStateName( nChunks ) ) )
+  {
+    G4cerr << "The scan histograms of the checkpoint are missing (" << GetScanStateName( nChunks ) << "), starting again" << G4endl;
+    return false;
+  }
+
+  G4Random::restoreEngineStatus( engineFile );
+  return true;
+}
+
+void ScanGrid::RemoveCheckpoint( G4int nChunks )
+{
+  std::remove( checkpointFile );
+  std::remove( engineFile );
+  std::remove( GetScanStateName( nChunks ).c_str() );
+  std::remove( GetScanStateName( -1 ).c_str() );
+}
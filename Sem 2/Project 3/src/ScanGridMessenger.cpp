@@ -0,0 +1,184 @@
+#include "ScanGridMessenger.h"
+#include "ScanGrid.h"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UImanager.hh"
+
+#include "Output.h"
+
+#include <algorithm>
+#include <sstream>
+
+ScanGridMessenger::ScanGridMessenger( ScanGrid* scanGrid ) : G4UImessenger(), m_scanGrid( scanGrid )
+{
+  m_directory = new G4UIdirectory( "/scan/" );
+  m_directory->SetGuidance( "The grid of beam particles, energies and fields, run with /scan/run" );
+
+  m_energiesCmd = this->MakeRangeCommand( "energies", "Beam energies to scan", "Energy", "MeV" );
+  m_fieldsCmd = this->MakeRangeCommand( "fields", "Magnetic fields (along x) to scan", "Magnetic flux density", "tesla" );
+
+  m_particlesCmd = new G4UIcmdWithAString( "/scan/particles", this );
+  m_particlesCmd->SetGuidance( "Beam particles to scan, separated by spaces, e.g. \"e- mu- pi-\"" );
+  m_particlesCmd->SetGuidance( "Without any, the particle set with /gun/particle is used" );
+  m_particlesCmd->SetParameterName( "particles", true );
+  m_particlesCmd->SetDefaultValue( "" );
+  m_particlesCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+  m_particlesCmd->SetToBeBroadcasted( false );
+
+  m_eventsPerPointCmd = new G4UIcmdWithAnInteger( "/scan/eventsPerPoint", this );
+  m_eventsPerPointCmd->SetGuidance( "Number of events at each point of the grid" );
+  m_eventsPerPointCmd->SetParameterName( "events", false );
+  m_eventsPerPointCmd->SetRange( "events > 0" );
+  m_eventsPerPointCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+  m_eventsPerPointCmd->SetToBeBroadcasted( false );
+
+  m_seedCmd = new G4UIcmdWithAnInteger( "/scan/seed", this );
+  m_seedCmd->SetGuidance( "Seed the random numbers of every event are made from, with its point and number" );
+  m_seedCmd->SetParameterName( "seed", false );
+  m_seedCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+  m_seedCmd->SetToBeBroadcasted( false );
+
+  m_checkpointEveryCmd = new G4UIcmdWithAnInteger( "/scan/checkpointEvery", this );
+  m_checkpointEveryCmd->SetGuidance( "Run /scan/run in chunks of this many events, saving the progress after each" );
+  m_checkpointEveryCmd->SetGuidance( "A job started with --resume skips the chunks already done; 0 runs in one go" );
+  m_checkpointEveryCmd->SetParameterName( "events", false );
+  m_checkpointEveryCmd->SetRange( "events >= 0" );
+  m_checkpointEveryCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+  m_checkpointEveryCmd->SetToBeBroadcasted( false );
+
+  m_runCmd = new G4UIcommand( "/scan/run", this );
+  m_runCmd->SetGuidance( "Run count points of the grid starting from point first, with /run/beamOn" );
+  m_runCmd->SetGuidance( "Without a count, run up to the end of the grid" );
+  m_runCmd->SetGuidance( "Separate processes can each run a slice, and the results join by appending rows" );
+  G4UIparameter* firstParameter = new G4UIparameter( "first", 'i', true );
+  firstParameter->SetDefaultValue( 0 );
+  firstParameter->SetParameterRange( "first >= 0" );
+  m_runCmd->SetParameter( firstParameter );
+  G4UIparameter* countParameter = new G4UIparameter( "count", 'i', true );
+  countParameter->SetDefaultValue( 0 );
+  countParameter->SetParameterRange( "count >= 0" );
+  m_runCmd->SetParameter( countParameter );
+  m_runCmd->AvailableForStates( G4State_Idle );
+  m_runCmd->SetToBeBroadcasted( false );
+}
+
+ScanGridMessenger::~ScanGridMessenger()
+{
+  delete m_energiesCmd;
+  delete m_fieldsCmd;
+  delete m_particlesCmd;
+  delete m_eventsPerPointCmd;
+  delete m_seedCmd;
+  delete m_checkpointEveryCmd;
+  delete m_runCmd;
+  delete m_directory;
+}
+
+// Each range takes a start, a stop and a step with a unit, e.g. /scan/energies 200 1190 10 MeV
+G4UIcommand* ScanGridMessenger::MakeRangeCommand( const G4String& name, const G4String& guidance,
+                                                  const G4String& unitCategory, const G4String& defaultUnit )
+{
+  G4UIcommand* command = new G4UIcommand( "/scan/" + name, this );
+  command->SetGuidance( guidance + ", from start to stop inclusive" );
+  command->SetGuidance( "A step of 0 gives the start value only" );
+  command->SetParameter( new G4UIparameter( "start", 'd', false ) );
+  command->SetParameter( new G4UIparameter( "stop", 'd', false ) );
+  G4UIparameter* stepParameter = new G4UIparameter( "step", 'd', false );
+  stepParameter->SetParameterRange( "step >= 0" );
+  command->SetParameter( stepParameter );
+  G4UIparameter* unitParameter = new G4UIparameter( "unit", 's', true );
+  unitParameter->SetDefaultValue( defaultUnit );
+  unitParameter->SetParameterCandidates( G4UIcommand::UnitsList( unitCategory ) );
+  command->SetParameter( unitParameter );
+  command->AvailableForStates( G4State_PreInit, G4State_Idle );
+  command->SetToBeBroadcasted( false );
+  return command;
+}
+
+void ScanGridMessenger::SetNewValue( G4UIcommand* command, G4String newValue )
+{
+  if ( command == m_energiesCmd || command == m_fieldsCmd )
+  {
+    G4double start = 0.0, stop = 0.0, step = 0.0;
+    G4String unit;
+    std::istringstream( newValue ) >> start >> stop >> step >> unit;
+    G4double scale = G4UIcommand::ValueOf( unit );
+    if ( command == m_energiesCmd ) m_scanGrid->SetEnergies( start * scale, stop * scale, step * scale );
+    else m_scanGrid->SetFields( start * scale, stop * scale, step * scale );
+  }
+  else if ( command == m_particlesCmd ) m_scanGrid->SetParticles( newValue );
+  else if ( command == m_eventsPerPointCmd ) m_scanGrid->SetEventsPerPoint( m_eventsPerPointCmd->GetNewIntValue( newValue ) );
+  else if ( command == m_seedCmd ) m_scanGrid->SetSeed( m_seedCmd->GetNewIntValue( newValue ) );
+  else if ( command == m_checkpointEveryCmd ) m_scanGrid->SetCheckpointEvery( m_checkpointEveryCmd->GetNewIntValue( newValue ) );
+  else if ( command == m_runCmd )
+  {
+    G4int first = 0, count = 0;
+    std::istringstream( newValue ) >> first >> count;
+    G4int nPoints = m_scanGrid->GetNumberOfPoints();
+    if ( first >= nPoints )
+    {
+      G4cerr << "/scan/run: the grid only has " << nPoints << " points" << G4endl;
+      return;
+    }
+    if ( count <= 0 || first + count > nPoints ) count = nPoints - first;
+
+    m_scanGrid->Print();
+    G4cout << "Running points " << first << " to " << first + count - 1 << G4endl;
+    this->RunSlice( G4long( first ) * m_scanGrid->GetEventsPerPoint(), G4long( count ) * m_scanGrid->GetEventsPerPoint() );
+  }
+}
+
+// Run count events of the scan from event first, in one go or in checkpointed chunks
+void ScanGridMessenger::RunSlice( G4long first, G4long count )
+{
+  auto uiManager = G4UImanager::GetUIpointer();
+  G4int every = m_scanGrid->GetCheckpointEvery();
+  if ( every <= 0 )
+  {
+    m_scanGrid->SetSegment( first, -1 );
+    uiManager->ApplyCommand( "/run/beamOn " + std::to_string( count ) );
+    m_scanGrid->SetSegment( 0, -1 );
+    return;
+  }
+
+  // Carry on from the last finished chunk, if this slice was started before
+  G4long done = 0;
+  G4int nChunks = 0;
+  if ( m_scanGrid->GetResume() && m_scanGrid->LoadCheckpoint( first, count, done, nChunks ) )
+  {
+    G4cout << "Resuming after " << done << " of " << count << " events (" << nChunks << " chunks)" << G4endl;
+  }
+  else
+  {
+    done = 0;
+    nChunks = 0;
+  }
+  m_scanGrid->SetResume( false );
+
+  while ( done < count )
+  {
+    G4long events = std::min( G4long( every ), count - done );
+    m_scanGrid->SetSegment( first + done, nChunks );
+    // A failed run leaves its chunk unfinished, to be run again
+    if ( uiManager->ApplyCommand( "/run/beamOn " + std::to_string( events ) ) != 0 ) break;
+    done += events;
+    ++nChunks;
+    m_scanGrid->SaveCheckpoint( first, count, done, nChunks );
+  }
+  m_scanGrid->SetSegment( 0, -1 );
+  if ( done < count ) return;
+
+  // Join the chunks into the files a single run would have written
+  std::vector< G4String > chunkNames;
+  for ( G4int chunk = 0; chunk < nChunks; ++chunk ) chunkNames.push_back( ScanGrid::GetOutputName( chunk ) );
+  if ( !Output::JoinChunks( chunkNames, ScanGrid::GetOutputName( -1 ) ) )
+  {
+    G4cerr << "/scan/run: the chunks could not be joined, they and the checkpoint are kept for --resume" << G4endl;
+    return;
+  }
+  ScanGrid::RemoveCheckpoint( nChunks );
+}
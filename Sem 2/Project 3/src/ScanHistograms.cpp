@@ -0,0 +1,218 @@
+#include "ScanHistograms.h"
+
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+ScanHistograms::ScanHistograms( G4int nRings, G4int depositBins, G4double maxDeposit )
+  : m_nRings( nRings ), m_depositBins( depositBins ), m_maxDeposit( maxDeposit )
+{
+}
+
+void ScanHistograms::AddEvent( const G4String& particle, G4double beamEnergy, G4double field,
+                               const std::vector< G4double >& ringEnergies )
+{
+  ScanPoint& point = m_points[ std::make_tuple( particle, beamEnergy, field ) ];
+  if ( point.nEvents == 0 )
+  {
+    point.sum.assign( m_nRings, 0.0 );
+    point.sum2.assign( m_nRings, 0.0 );
+  }
+  ++point.nEvents;
+  for ( G4int ring = 0; ring < m_nRings; ++ring )
+  {
+    point.sum[ ring ] += ringEnergies[ ring ];
+    point.sum2[ ring ] += ringEnergies[ ring ] * ringEnergies[ ring ];
+  }
+
+  std::vector< G4int >& profile = m_profiles[ std::make_pair( particle, beamEnergy ) ];
+  if ( profile.empty() ) profile.assign( m_nRings * ( m_depositBins + 1 ), 0 );
+  for ( G4int ring = 0; ring < m_nRings; ++ring )
+  {
+    G4int bin = std::min( G4int( ringEnergies[ ring ] / m_maxDeposit * m_depositBins ), m_depositBins );
+    ++profile[ ring * ( m_depositBins + 1 ) + bin ];
+  }
+}
+
+// Join the results of another thread, which must use the same rings and binning
+void ScanHistograms::Merge( const ScanHistograms& other )
+{
+  for ( const auto& otherPoint : other.m_points )
+  {
+    ScanPoint& point = m_points[ otherPoint.first ];
+    if ( point.nEvents == 0 )
+    {
+      point = otherPoint.second;
+      continue;
+    }
+    point.nEvents += otherPoint.second.nEvents;
+    for ( G4int ring = 0; ring < m_nRings; ++ring )
+    {
+      point.sum[ ring ] += otherPoint.second.sum[ ring ];
+      point.sum2[ ring ] += otherPoint.second.sum2[ ring ];
+    }
+  }
+
+  for ( const auto& otherProfile : other.m_profiles )
+  {
+    std::vector< G4int >& profile = m_profiles[ otherProfile.first ];
+    if ( profile.empty() ) profile.assign( otherProfile.second.size(), 0 );
+    for ( std::size_t bin = 0; bin < profile.size(); ++bin ) profile[ bin ] += otherProfile.second[ bin ];
+  }
+}
+
+G4long ScanHistograms::Write( const G4String& outputName ) const
+{
+  // One row per scan point, energies in MeV and the field in tesla
+  // Files from runs over different points can be joined by appending the rows
+  std::ofstream scan( outputName + "_scan.csv" );
+  scan << "Particle,Generated,Magnetic field,Events";
+  for ( G4int ring = 1; ring <= m_nRings; ++ring ) scan << ",Mean" << ring;
+  for ( G4int ring = 1; ring <= m_nRings; ++ring ) scan << ",RMS" << ring;
+  scan << "\n";
+  for ( const auto& point : m_points )
+  {
+    G4int n = point.second.nEvents;
+    scan << std::get< 0 >( point.first ) << "," << std::get< 1 >( point.first ) / MeV << ","
+         << std::get< 2 >( point.first ) / tesla << "," << n;
+    for ( G4int ring = 0; ring < m_nRings; ++ring ) scan << "," << point.second.sum[ ring ] / n / MeV;
+    for ( G4int ring = 0; ring < m_nRings; ++ring )
+    {
+      G4double mean = point.second.sum[ ring ] / n;
+      scan << "," << std::sqrt( std::max( point.second.sum2[ ring ] / n - mean * mean, 0.0 ) ) / MeV;
+    }
+    scan << "\n";
+  }
+
+  // One row per beam energy and ring, with the bin edges in the header
+  std::ofstream profile( outputName + "_profile.csv" );
+  profile << "Particle,Generated,Ring";
+  for ( G4int bin = 0; bin < m_depositBins; ++bin ) profile << "," << bin * m_maxDeposit / m_depositBins / MeV;
+  profile << ",Overflow\n";
+  for ( const auto& energyProfile : m_profiles )
+  {
+    for ( G4int ring = 0; ring < m_nRings; ++ring )
+    {
+      profile << energyProfile.first.first << "," << energyProfile.first.second / MeV << "," << ring + 1;
+      for ( G4int bin = 0; bin <= m_depositBins; ++bin ) profile << "," << energyProfile.second[ ring * ( m_depositBins + 1 ) + bin ];
+      profile << "\n";
+    }
+  }
+
+  return G4long( scan.tellp() ) + G4long( profile.tellp() );
+}
+
+namespace
+{
+  template< typename T > void WriteValue( std::ofstream& file, const T& value )
+  {
+    file.write( reinterpret_cast< const char* >( &value ), sizeof( T ) );
+  }
+
+  template< typename T > void WriteValues( std::ofstream& file, const std::vector< T >& values )
+  {
+    file.write( reinterpret_cast< const char* >( values.data() ), values.size() * sizeof( T ) );
+  }
+
+  void WriteString( std::ofstream& file, const G4String& text )
+  {
+    WriteValue( file, G4int( text.size() ) );
+    file.write( text.data(), text.size() );
+  }
+
+  template< typename T > void ReadValue( std::ifstream& file, T& value )
+  {
+    file.read( reinterpret_cast< char* >( &value ), sizeof( T ) );
+  }
+
+  template< typename T > void ReadValues( std::ifstream& file, std::vector< T >& values, std::size_t n )
+  {
+    values.resize( n );
+    file.read( reinterpret_cast< char* >( values.data() ), n * sizeof( T ) );
+  }
+
+  void ReadString( std::ifstream& file, G4String& text )
+  {
+    G4int size = 0;
+    ReadValue( file, size );
+    std::string buffer( std::max( size, 0 ), ' ' );
+    file.read( &buffer[ 0 ], buffer.size() );
+    text = buffer;
+  }
+}
+
+void ScanHistograms::Save( const G4String& fileName, G4int nChunks ) const
+{
+  std::ofstream file( fileName, std::ios::binary );
+  WriteValue( file, nChunks );
+  WriteValue( file, m_nRings );
+  WriteValue( file, m_depositBins );
+  WriteValue( file, m_maxDeposit );
+
+  WriteValue( file, G4int( m_points.size() ) );
+  for ( const auto& point : m_points )
+  {
+    WriteString( file, std::get< 0 >( point.first ) );
+    WriteValue( file, std::get< 1 >( point.first ) );
+    WriteValue( file, std::get< 2 >( point.first ) );
+    WriteValue( file, point.second.nEvents );
+    WriteValues( file, point.second.sum );
+    WriteValues( file, point.second.sum2 );
+  }
+
+  WriteValue( file, G4int( m_profiles.size() ) );
+  for ( const auto& profile : m_profiles )
+  {
+    WriteString( file, profile.first.first );
+    WriteValue( file, profile.first.second );
+    WriteValues( file, profile.second );
+  }
+}
+
+G4bool ScanHistograms::Load( const G4String& fileName, G4int nChunks )
+{
+  std::ifstream file( fileName, std::ios::binary );
+  G4int savedChunks = -1, nRings = 0, depositBins = 0;
+  G4double maxDeposit = 0.0;
+  ReadValue( file, savedChunks );
+  ReadValue( file, nRings );
+  ReadValue( file, depositBins );
+  ReadValue( file, maxDeposit );
+  if ( !file || savedChunks != nChunks || nRings != m_nRings || depositBins != m_depositBins || maxDeposit != m_maxDeposit ) return false;
+
+  m_points.clear();
+  G4int nPoints = 0;
+  ReadValue( file, nPoints );
+  for ( G4int i = 0; i < nPoints && file; ++i )
+  {
+    G4String particle;
+    G4double energy = 0.0, field = 0.0;
+    ReadString( file, particle );
+    ReadValue( file, energy );
+    ReadValue( file, field );
+    ScanPoint& point = m_points[ std::make_tuple( particle, energy, field ) ];
+    ReadValue( file, point.nEvents );
+    ReadValues( file, point.sum, m_nRings );
+    ReadValues( file, point.sum2, m_nRings );
+  }
+
+  m_profiles.clear();
+  G4int nProfiles = 0;
+  ReadValue( file, nProfiles );
+  for ( G4int i = 0; i < nProfiles && file; ++i )
+  {
+    G4String particle;
+    G4double energy = 0.0;
+    ReadString( file, particle );
+    ReadValue( file, energy );
+    ReadValues( file, m_profiles[ std::make_pair( particle, energy ) ], m_nRings * ( m_depositBins + 1 ) );
+  }
+
+  // Nothing may be left over, or the file was not written by this binning
+  if ( file && file.peek() == std::ifstream::traits_type::eof() ) return true;
+  m_points.clear();
+  m_profiles.clear();
+  return false;
+}
@@ -0,0 +1,15 @@
+#include "SteppingAction.h"
+#include "RunAction.h"
+
+SteppingAction::SteppingAction( RunAction* runAction ) : G4UserSteppingAction(), m_runAction( runAction )
+{
+}
+
+SteppingAction::~SteppingAction()
+{
+}
+
+void SteppingAction::UserSteppingAction( const G4Step* )
+{
+  m_runAction->CountStep();
+}
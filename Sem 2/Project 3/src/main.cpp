@@ -1,17 +1,57 @@
 #include "DetectorConstruction.h"
 #include "ActionInitialization.h"
+#include "ScanGrid.h"
+#include "Output.h"
 
+#ifdef G4MULTITHREADED
+#include "G4MTRunManager.hh"
+#else
 #include "G4RunManager.hh"
+#endif
 #include "G4UImanager.hh"
+#include "G4ScoringManager.hh"
 #include "FTFP_BERT.hh"
 #include "G4StepLimiterPhysics.hh"
+#include "G4FastSimulationPhysics.hh"
 #include "Randomize.hh"
 #include "G4VisExecutive.hh"
 #include "G4UIExecutive.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <cstdlib>
 
 
 int main( int argc, char* argv[] )
 {
+  // Options on the command line
+  // -t N: number of worker threads, default all cores
+  // -o csv|root|xml|bin|hdf5: output format, default csv (hdf5 needs Geant4 built with HDF5)
+  // -z N: compression level of the output (ROOT, HDF5 and bin), default 1
+  // -c N: rows per chunk of the bin output, default 4096
+  // --resume: carry on a checkpointed /scan/run after its last finished chunk
+  G4int nThreads = 0;
+  G4bool resume = false;
+  for ( G4int i = 1; i < argc; ++i )
+  {
+    if ( G4String( argv[i] ) == "--resume" ) resume = true;
+  }
+  for ( G4int i = 1; i < argc - 1; ++i )
+  {
+    G4String option = argv[i];
+    if ( option == "-t" ) nThreads = std::atoi( argv[i+1] );
+    else if ( option == "-o" && !Output::SetFormat( argv[i+1] ) )
+    {
+      G4cerr << "Unknown output format " << argv[i+1] << ", use csv, root, xml, bin";
+#ifdef WITH_HDF5
+      G4cerr << " or hdf5";
+#endif
+      G4cerr << G4endl;
+      return 1;
+    }
+    else if ( option == "-z" ) Output::SetCompressionLevel( std::atoi( argv[i+1] ) );
+    else if ( option == "-c" ) Output::SetChunkSize( std::atoi( argv[i+1] ) );
+  }
+
   // Start interactive session using the command line arguments
   G4UIExecutive* ui = new G4UIExecutive( argc, argv );
 
@@ -19,8 +59,17 @@ int main( int argc, char* argv[] )
   G4Random::setTheEngine( new CLHEP::RanecuEngine );
   G4Random::setTheSeed( 1234 );
 
-  // Construct the default run manager
+  // Construct the run manager, with one worker per thread if Geant4 allows it
+#ifdef G4MULTITHREADED
+  G4MTRunManager* runManager = new G4MTRunManager();
+  if ( nThreads <= 0 ) nThreads = G4Threading::G4GetNumberOfCores();
+  runManager->SetNumberOfThreads( nThreads );
+#else
   G4RunManager* runManager = new G4RunManager();
+#endif
+
+  // Enable the /score/ commands, for meshes that score without any geometry
+  G4ScoringManager::GetScoringManager();
 
   // Set up detector
   runManager->SetUserInitialization( new DetectorConstruction() );
@@ -28,10 +77,21 @@ int main( int argc, char* argv[] )
   // Set up physics processes
   G4VModularPhysicsList* physicsList = new FTFP_BERT();
   physicsList->RegisterPhysics( new G4StepLimiterPhysics() );
+  // Let electrons and positrons be handed to the GFlash model of FastShower
+  G4FastSimulationPhysics* fastSimulationPhysics = new G4FastSimulationPhysics();
+  fastSimulationPhysics->ActivateFastSimulation( "e-" );
+  fastSimulationPhysics->ActivateFastSimulation( "e+" );
+  physicsList->RegisterPhysics( fastSimulationPhysics );
+  // Coarse cuts outside the detector regions, which set their own in DetectorConstruction
+  physicsList->SetDefaultCutValue( 1.0*m );
   runManager->SetUserInitialization( physicsList );
 
+  // The scan all threads generate from, set up with /scan/
+  ScanGrid* scanGrid = new ScanGrid();
+  scanGrid->SetResume( resume );
+
   // Set user action classes (just the generator really)
-  runManager->SetUserInitialization( new ActionInitialization() );
+  runManager->SetUserInitialization( new ActionInitialization( scanGrid ) );
 
   // Set up display
   // G4VisManager* visManager = new G4VisExecutive();
@@ -51,4 +111,5 @@ int main( int argc, char* argv[] )
   //
   // delete visManager;
   delete runManager;
+  delete scanGrid;
 }
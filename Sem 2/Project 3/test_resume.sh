@@ -0,0 +1,75 @@
+#!/bin/sh
+# Check that a checkpointed scan stopped part way and carried on with
+# --resume gives the same files, byte for byte, as one run in one go, with
+# several worker threads and the rows written in whatever order they finish
+#
+#     ./test_resume.sh build/MyProgram [threads]
+#
+# For each of the csv and bin formats, in a scratch directory:
+# - run the scan once, uninterrupted
+# - run it again, kill the job as soon as its first checkpoint is written,
+#   then run it with --resume
+# - compare the joined Energy tables
+
+program=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+threads=${2:-4}
+if [ ! -x "$program" ]; then
+  echo "usage: $0 path/to/MyProgram [threads]"
+  exit 2
+fi
+
+scratch=$(mktemp -d)
+trap 'rm -rf "$scratch"' EXIT
+
+# 4 points of 100 events, in chunks of 40, so the job is killed well before the end
+write_macros()
+{
+  echo "/run/initialize" > "$1/vis.mac"
+  cat > "$1/run.mac" <<EOF
+/summary/printEvery 0
+/scan/energies 200 300 100 MeV
+/scan/fields 0 0.1 0.1 tesla
+/scan/eventsPerPoint 100
+/scan/seed 4321
+/scan/checkpointEvery 40
+/scan/run
+EOF
+}
+
+status=0
+for format in csv bin; do
+  table=output_nt_Energy.$format
+
+  mkdir "$scratch/$format" "$scratch/$format/whole" "$scratch/$format/resumed"
+  write_macros "$scratch/$format/whole"
+  write_macros "$scratch/$format/resumed"
+
+  ( cd "$scratch/$format/whole" && "$program" -t "$threads" -o "$format" > log.txt 2>&1 )
+
+  # Stop the job the moment the first chunk is saved, as a preemption would
+  cd "$scratch/$format/resumed"
+  "$program" -t "$threads" -o "$format" > log1.txt 2>&1 &
+  job=$!
+  while kill -0 $job 2> /dev/null && [ ! -f output.checkpoint ]; do sleep 0.05; done
+  kill -9 $job 2> /dev/null
+  wait $job 2> /dev/null
+  if [ -f "$table" ] || [ ! -f output.checkpoint ]; then
+    echo "$format: the job finished before it could be stopped"
+    status=1
+    cd - > /dev/null
+    continue
+  fi
+  "$program" -t "$threads" -o "$format" --resume > log2.txt 2>&1
+  cd - > /dev/null
+
+  if ! grep -q "Resuming after" "$scratch/$format/resumed/log2.txt"; then
+    echo "$format: the second job did not resume"
+    status=1
+  elif ! cmp "$scratch/$format/whole/$table" "$scratch/$format/resumed/$table"; then
+    echo "$format: the resumed scan differs from the uninterrupted one"
+    status=1
+  else
+    echo "$format: resumed and uninterrupted scans are identical"
+  fi
+done
+exit $status
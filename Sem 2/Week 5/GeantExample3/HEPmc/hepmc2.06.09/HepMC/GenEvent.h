@@ -308,6 +308,17 @@ namespace HepMC {
 	/// the string must match the enum exactly
 	/// This method will NOT convert momentum and position data
         void define_units( std::string&, std::string& );
+
+	// boost, rotate, and shift_vertices are convenience calls that loop
+	// over the particles and vertices, no faster than doing it by hand
+	/// Lorentz boost all momenta and vertex positions by the velocity beta
+	/// returns false and does nothing if |beta| >= 1
+	bool boost( const ThreeVector& beta );
+	/// rotate all momenta and vertex positions by angle (radians) about axis
+	/// returns false and does nothing if axis is null
+	bool rotate( const ThreeVector& axis, double angle );
+	/// translate all vertex positions by dx (in this event's length units)
+	void shift_vertices( const FourVector& dx );
 	
 	/// vertex range
 	GenEventVertexRange vertex_range();
@@ -651,6 +662,10 @@ namespace HepMC {
     /// set the units for this input stream
     std::istream & set_input_units(std::istream &, 
                                    Units::MomentumUnit, Units::LengthUnit);
+    /// deliver events read from this input stream in these units,
+    /// converting on the fly whatever units are written in the file
+    std::istream & set_target_units(std::istream &, 
+                                    Units::MomentumUnit, Units::LengthUnit);
     /// Explicitly write the begin block lines that IO_GenEvent uses
     std::ostream & write_HepMC_IO_block_begin(std::ostream & );
     /// Explicitly write the end block line that IO_GenEvent uses
@@ -853,11 +868,6 @@ namespace HepMC {
         return m_position_unit; 
     }
     
-    inline void GenEvent::use_units( Units::MomentumUnit new_m, Units::LengthUnit new_l ) { 
-       use_momentum_unit( new_m );
-       use_length_unit( new_l );
-    }
-    
     inline void GenEvent::use_units( std::string& new_m, std::string& new_l ) { 
        use_momentum_unit( new_m );
        use_length_unit( new_l );
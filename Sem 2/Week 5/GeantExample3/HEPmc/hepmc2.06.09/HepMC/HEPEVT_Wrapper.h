@@ -117,10 +117,54 @@ extern "C" {
 //
 
 #include <iostream>
+#include <vector>
 #include <cstdio>       // needed for formatted output using sprintf 
 
 namespace HepMC {
 
+    //! Decoded copy of the whole HEPEVT common block
+
+    /// \class HEPEVT_Arrays
+    /// Plain C++ arrays laid out like the fortran common block, 
+    /// so that a generator interface can read or fill every entry 
+    /// without going through the per-entry byte offset accessors.
+    /// Entry 0 is unused: index i refers to the fortran entry i.
+    /// Filled by HEPEVT_Wrapper::read_arrays and copied back with
+    /// HEPEVT_Wrapper::write_arrays.
+    ///
+    struct HEPEVT_Arrays {
+	int nevhep;                 //!< event number
+	int nhep;                   //!< number of entries
+	std::vector<int>    isthep; //!< status code, 1 per entry
+	std::vector<int>    idhep;  //!< PDG id, 1 per entry
+	std::vector<int>    jmohep; //!< first and last mother, 2 per entry
+	std::vector<int>    jdahep; //!< first and last daughter, 2 per entry
+	std::vector<double> phep;   //!< px, py, pz, e, m, 5 per entry
+	std::vector<double> vhep;   //!< x, y, z, t, 4 per entry
+
+	HEPEVT_Arrays() : nevhep(0), nhep(0) {}
+	/// make room for n entries and set nhep = n
+	void resize( int n );
+
+	int    first_parent( int i ) const { return jmohep[2*i]; }
+	int    last_parent( int i )  const { return jmohep[2*i+1]; }
+	int    number_parents( int i ) const
+	{ return jmohep[2*i] > 0 ? 1 + jmohep[2*i+1] - jmohep[2*i] : 0; }
+	int    first_child( int i )  const { return jdahep[2*i]; }
+	int    last_child( int i )   const { return jdahep[2*i+1]; }
+	int    number_children( int i ) const
+	{ return jdahep[2*i] > 0 ? 1 + jdahep[2*i+1] - jdahep[2*i] : 0; }
+	double px( int i ) const { return phep[5*i]; }
+	double py( int i ) const { return phep[5*i+1]; }
+	double pz( int i ) const { return phep[5*i+2]; }
+	double e( int i )  const { return phep[5*i+3]; }
+	double m( int i )  const { return phep[5*i+4]; }
+	double x( int i )  const { return vhep[4*i]; }
+	double y( int i )  const { return vhep[4*i+1]; }
+	double z( int i )  const { return vhep[4*i+2]; }
+	double t( int i )  const { return vhep[4*i+3]; }
+    };
+
     //! Generic Wrapper for the fortran HEPEVT common block
     
     /// \class HEPEVT_Wrapper
@@ -190,6 +234,22 @@ namespace HepMC {
 	/// set particle production vertex
         static void set_position( int index, double x, double y, double z, 
 				  double t );
+
+	////////////////////
+	// Bulk Methods   //
+	////////////////////
+
+	/// Copy the whole common block into a in one pass.
+	/// The parent and child pointers are range checked the same way
+	/// as first_parent(), last_parent(), first_child(), and last_child(),
+	/// and the number of entries is clamped to [0, max_number_entries()].
+	/// Returns false if the block does not fit in the allocation.
+	static bool read_arrays( HEPEVT_Arrays& a );
+	/// Copy a into the common block in one pass.
+	/// Entries beyond max_number_entries() are dropped, and a negative
+	/// number of entries is written as 0.
+	/// Returns false if the block does not fit in the allocation.
+	static bool write_arrays( const HEPEVT_Arrays& a );
 	//////////////////////
 	// HEPEVT Floorplan //
 	//////////////////////
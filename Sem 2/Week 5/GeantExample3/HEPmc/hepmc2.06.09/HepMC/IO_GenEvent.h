@@ -92,6 +92,11 @@ public:
     /// This method is not necessary if the units are written in the file
     void use_input_units( Units::MomentumUnit, Units::LengthUnit );
 
+    /// deliver every event in these units, whatever units the file uses
+    /// The conversion is done while the file is parsed, so reading 
+    /// a GeV file into a MeV job costs the same as a same-unit read.
+    void use_target_units( Units::MomentumUnit, Units::LengthUnit );
+
     /// set output precision
     /// The default precision is 16.
     void precision( int );
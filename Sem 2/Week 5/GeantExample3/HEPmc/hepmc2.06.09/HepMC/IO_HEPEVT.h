@@ -85,6 +85,8 @@ namespace HepMC {
 	void              set_trust_beam_particles( bool b = true );
 
     protected: // for internal use only
+	// build_particle, build_production_vertex, and build_end_vertex
+	// read the copy of the common block made by fill_next_event
         /// create a GenParticle
 	GenParticle* build_particle( int index );
         /// create a production vertex
@@ -106,6 +108,7 @@ namespace HepMC {
 	bool m_trust_both_mothers_and_daughters;
 	bool m_print_inconsistency_errors; 
 	bool m_trust_beam_particles;
+	HEPEVT_Arrays m_hepevt;  //!< copy of the common block for this event
     };
 
     ////////////////////////////
@@ -0,0 +1,134 @@
+//--------------------------------------------------------------------------
+#ifndef HEPMC_PILEUP_OVERLAY_H
+#define HEPMC_PILEUP_OVERLAY_H
+
+//////////////////////////////////////////////////////////////////////////
+// Merge a signal event with pileup (minimum bias) events.
+//
+// PileupOverlay copies K events into one GenEvent.  Sub-event k
+// (k = 0 is the signal) has its particle barcodes shifted by
+// +k*barcode_stride and its vertex barcodes by -k*barcode_stride, so
+// the origin of every particle and vertex can be recovered from its
+// barcode alone, also after the merged event has been written out.
+//
+// PileupLibrary gives random access to the events of an IO_GenEvent
+// file.  The file is indexed once and events are parsed on demand and
+// kept in a bounded cache, so that a small minimum bias sample can be
+// reused for many overlays.
+//////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "HepMC/GenEvent.h"
+
+namespace HepMC {
+
+    //! Merges a signal event with pileup events
+
+    ///
+    /// \class PileupOverlay
+    /// Builds one GenEvent from a signal event and any number of pileup
+    /// events, with deterministic barcode remapping and optional
+    /// Gaussian smearing of the vertex positions of each sub-event.
+    /// The merged event takes its units, header information,
+    /// signal process vertex, and beam particles from the signal event.
+    /// Pileup events in other units are converted while they are copied.
+    ///
+    class PileupOverlay {
+    public:
+	/// barcode_stride must be larger than the largest |barcode|
+	/// of any input event
+	PileupOverlay( int barcode_stride = 1000000 );
+
+	/// Merge signal and pileup into a new event owned by the caller.
+	/// Returns 0 if an input barcode does not fit in the stride
+	/// or if there are too many sub-events for the stride.
+	GenEvent* overlay( const GenEvent& signal,
+	                   const std::vector<const GenEvent*>& pileup );
+
+	/// sub-event (0 = signal) of a barcode in a merged event
+	int  sub_event( int barcode ) const;
+	/// barcode offset between sub-events
+	int  barcode_stride() const { return m_stride; }
+	/// largest number of sub-events (signal included) that fit in int
+	int  max_sub_events() const;
+
+	/// Gaussian smearing of the vertex positions of each pileup event,
+	/// in the length units of the signal event.  All vertices of one
+	/// sub-event are moved by the same random shift.
+	/// All sigmas zero (the default) switches smearing off.
+	void set_vertex_smearing( double sigma_x, double sigma_y,
+	                          double sigma_z, double sigma_t = 0 );
+	/// smear the signal event as well (default is false)
+	void set_smear_signal( bool b = true ) { m_smear_signal = b; }
+	/// seed of the smearing random numbers
+	void set_seed( long seed );
+
+    private:
+	bool fits( const GenEvent& in ) const;
+	void add_sub_event( const GenEvent& in, int k, GenEvent& out );
+	double uniform();
+	double gauss();
+
+	int    m_stride;
+	double m_sigma[4];
+	bool   m_smear;
+	bool   m_smear_signal;
+	long   m_seed;
+	bool   m_has_spare;
+	double m_spare;
+	/// old vertex barcode to new vertex, reused between calls
+	std::vector<GenVertex*> m_vertex_lookup;
+    };
+
+    //! Random access to the events of an IO_GenEvent file
+
+    ///
+    /// \class PileupLibrary
+    /// The file is scanned once for the start of each event, then
+    /// events are read on request.  At most cache_size parsed events
+    /// are kept; the oldest is dropped first.
+    ///
+    class PileupLibrary {
+    public:
+	PileupLibrary( const std::string& filename,
+	               std::size_t cache_size = 1000 );
+	~PileupLibrary();
+
+	/// false if the file could not be opened or holds no events
+	bool        is_valid() const { return !m_offsets.empty(); }
+	/// number of events in the file
+	std::size_t size() const { return m_offsets.size(); }
+	/// Event i of the file, 0 if i is out of range or unreadable.
+	/// The pointer stays valid for at least cache_size further requests.
+	const GenEvent* event( std::size_t i );
+	/// Fill v with the next n events of the file, starting again from
+	/// the first event when the end is reached.  The cache is grown
+	/// to n if needed, so all n pointers are valid together.
+	void next_events( std::size_t n, std::vector<const GenEvent*>& v );
+	/// number of events parsed so far
+	std::size_t events_parsed() const { return m_parsed; }
+
+    private: // copying is not allowed
+	PileupLibrary( const PileupLibrary& );
+	PileupLibrary& operator=( const PileupLibrary& );
+
+    private:
+	std::ifstream                        m_file;
+	std::vector<std::streampos>          m_offsets;
+	std::map<std::size_t,GenEvent*>      m_cache;
+	std::deque<std::size_t>              m_cache_order;
+	std::size_t                          m_cache_size;
+	std::size_t                          m_next;
+	std::size_t                          m_parsed;
+    };
+
+} // HepMC
+
+#endif  // HEPMC_PILEUP_OVERLAY_H
+//--------------------------------------------------------------------------
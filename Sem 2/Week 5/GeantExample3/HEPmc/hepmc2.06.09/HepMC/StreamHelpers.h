@@ -25,11 +25,16 @@ std::istream & establish_input_stream_info( std::istream & );
 
 /// get a GenVertex from ASCII input
 /// TempParticleMap is used to track the associations of particles with vertices
-std::istream & read_vertex( std::istream &, TempParticleMap &, GenVertex * );
+/// momenta and positions are multiplied by the given factors as they are read
+std::istream & read_vertex( std::istream &, TempParticleMap &, GenVertex *,
+                            double momentum_factor = 1.,
+                            double length_factor = 1. );
 
 /// get a GenParticle from ASCII input
 /// TempParticleMap is used to track the associations of particles with vertices
-std::istream & read_particle( std::istream&, TempParticleMap &, GenParticle * );
+/// the momentum is multiplied by the given factor as it is read
+std::istream & read_particle( std::istream&, TempParticleMap &, GenParticle *,
+                              double momentum_factor = 1. );
 
 /// write a double - for internal use by streaming IO
 inline std::ostream & output( std::ostream & os, const double& d ) {
@@ -87,6 +87,18 @@ public:
     /// (e.g., the default units are MeV, but the file was written with GeV)
     /// This method is not necessary if the units are written in the file
     void use_input_units( Units::MomentumUnit, Units::LengthUnit );
+
+    /// request that events read from this stream are delivered in these 
+    /// units, whatever units are written in the file
+    /// The conversion is applied while each P and V line is parsed,
+    /// so no second pass over the event is needed.
+    void use_target_units( Units::MomentumUnit, Units::LengthUnit );
+    /// true if use_target_units has been called for this stream
+    bool has_target_units() const { return m_has_target_units; }
+    /// get the requested momentum units
+    Units::MomentumUnit target_momentum_unit() const { return m_target_momentum_unit; }
+    /// get the requested length units
+    Units::LengthUnit target_position_unit() const { return m_target_position_unit; }
     
     /// reading_event_header will return true when streaming input is 
     /// processing the GenEvent header information
@@ -114,6 +126,10 @@ private: // data members
     // default io units - used only when reading a file with no units
     Units::MomentumUnit m_io_momentum_unit;
     Units::LengthUnit   m_io_position_unit;
+    // units requested by the reader - applied while parsing
+    bool                m_has_target_units;
+    Units::MomentumUnit m_target_momentum_unit;
+    Units::LengthUnit   m_target_position_unit;
     // used to keep identify the I/O stream
     unsigned int m_stream_id;
     static unsigned int m_stream_counter;
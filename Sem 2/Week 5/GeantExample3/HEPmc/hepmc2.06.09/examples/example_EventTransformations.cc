@@ -0,0 +1,170 @@
+//////////////////////////////////////////////////////////////////////////
+// Example of whole-event Lorentz transformations.
+// Reads the events written by example_MyPythia.cc (or the file named on
+// the command line) into memory, then times a boost, a rotation, and a
+// vertex shift done particle by particle against the same operations
+// done with GenEvent::boost, GenEvent::rotate, and
+// GenEvent::shift_vertices.  The momentum balance of every vertex is
+// summed with GenVertex::check_momentum_conservation after each pass.
+// The GenEvent calls are a convenience, not a faster path: both ways
+// should take about the same time.
+//////////////////////////////////////////////////////////////////////////
+// To Compile: go to the HepMC directory and type:
+// gmake examples/example_EventTransformations.exe
+//
+
+#include <cmath>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+#include "HepMC/IO_GenEvent.h"
+#include "HepMC/GenEvent.h"
+
+/// boost every particle and vertex of evt one at a time
+void scalarBoost( HepMC::GenEvent* evt, const HepMC::ThreeVector& b )
+{
+    double b2 = b.x()*b.x() + b.y()*b.y() + b.z()*b.z();
+    double gamma = 1.0/std::sqrt(1.0 - b2);
+    double gamma2 = b2 > 0 ? (gamma - 1.0)/b2 : 0.0;
+    for ( HepMC::GenEvent::particle_iterator p = evt->particles_begin();
+          p != evt->particles_end(); ++p ) {
+	HepMC::FourVector m = (*p)->momentum();
+	double bp = b.x()*m.px() + b.y()*m.py() + b.z()*m.pz();
+	double f = gamma2*bp + gamma*m.e();
+	(*p)->set_momentum( HepMC::FourVector( m.px() + f*b.x(),
+	                                       m.py() + f*b.y(),
+	                                       m.pz() + f*b.z(),
+	                                       gamma*(m.e() + bp) ) );
+    }
+    for ( HepMC::GenEvent::vertex_iterator v = evt->vertices_begin();
+          v != evt->vertices_end(); ++v ) {
+	HepMC::FourVector x = (*v)->position();
+	double bp = b.x()*x.x() + b.y()*x.y() + b.z()*x.z();
+	double f = gamma2*bp + gamma*x.t();
+	(*v)->set_position( HepMC::FourVector( x.x() + f*b.x(),
+	                                       x.y() + f*b.y(),
+	                                       x.z() + f*b.z(),
+	                                       gamma*(x.t() + bp) ) );
+    }
+}
+
+/// rotate every particle and vertex of evt about z one at a time
+void scalarRotateZ( HepMC::GenEvent* evt, double angle )
+{
+    double c = std::cos(angle), s = std::sin(angle);
+    for ( HepMC::GenEvent::particle_iterator p = evt->particles_begin();
+          p != evt->particles_end(); ++p ) {
+	HepMC::FourVector m = (*p)->momentum();
+	(*p)->set_momentum( HepMC::FourVector( c*m.px() - s*m.py(),
+	                                       s*m.px() + c*m.py(),
+	                                       m.pz(), m.e() ) );
+    }
+    for ( HepMC::GenEvent::vertex_iterator v = evt->vertices_begin();
+          v != evt->vertices_end(); ++v ) {
+	HepMC::FourVector x = (*v)->position();
+	(*v)->set_position( HepMC::FourVector( c*x.x() - s*x.y(),
+	                                       s*x.x() + c*x.y(),
+	                                       x.z(), x.t() ) );
+    }
+}
+
+/// shift every vertex of evt one at a time
+void scalarShift( HepMC::GenEvent* evt, const HepMC::FourVector& dx )
+{
+    for ( HepMC::GenEvent::vertex_iterator v = evt->vertices_begin();
+          v != evt->vertices_end(); ++v ) {
+	HepMC::FourVector x = (*v)->position();
+	(*v)->set_position( HepMC::FourVector( x.x() + dx.x(), x.y() + dx.y(),
+	                                       x.z() + dx.z(), x.t() + dx.t() ) );
+    }
+}
+
+/// sum of |p_in - p_out| over all vertices of all events
+double momentumBalance( const std::vector<HepMC::GenEvent*>& events )
+{
+    double sum = 0;
+    for ( std::size_t i = 0; i < events.size(); ++i ) {
+	for ( HepMC::GenEvent::vertex_const_iterator v = events[i]->vertices_begin();
+	      v != events[i]->vertices_end(); ++v ) {
+	    sum += (*v)->check_momentum_conservation();
+	}
+    }
+    return sum;
+}
+
+double seconds( std::clock_t start )
+{
+    return double( std::clock() - start ) / CLOCKS_PER_SEC;
+}
+
+int main( int argc, char** argv ) {
+    const char* infile = argc > 1 ? argv[1] : "example_MyPythia.dat";
+    const int npass = 20;
+    HepMC::ThreeVector beta( 0., 0., 0.3 );
+    HepMC::FourVector dx( 0.1, -0.2, 5., 0. );
+    double angle = 0.01;
+    //........................................READ EVENTS
+    std::vector<HepMC::GenEvent*> scalar_events;
+    std::vector<HepMC::GenEvent*> batch_events;
+    { // begin scope of ascii_in
+	HepMC::IO_GenEvent ascii_in(infile,std::ios::in);
+	HepMC::GenEvent* evt = ascii_in.read_next_event();
+	while ( evt ) {
+	    scalar_events.push_back( evt );
+	    batch_events.push_back( new HepMC::GenEvent( *evt ) );
+	    evt = ascii_in.read_next_event();
+	}
+    } // end scope of ascii_in
+    if ( scalar_events.empty() ) {
+	std::cerr << "no events found in " << infile << std::endl;
+	return 1;
+    }
+    long nparticles = 0;
+    for ( std::size_t i = 0; i < scalar_events.size(); ++i ) {
+	nparticles += scalar_events[i]->particles_size();
+    }
+    std::cout << "Read " << scalar_events.size() << " events with "
+	      << nparticles << " particles from " << infile << std::endl;
+    std::cout << "Momentum balance before: "
+	      << momentumBalance( scalar_events ) << std::endl;
+    //........................................PARTICLE BY PARTICLE
+    std::clock_t start = std::clock();
+    for ( int pass = 0; pass < npass; ++pass ) {
+	for ( std::size_t i = 0; i < scalar_events.size(); ++i ) {
+	    scalarBoost( scalar_events[i], beta );
+	    scalarRotateZ( scalar_events[i], angle );
+	    scalarShift( scalar_events[i], dx );
+	}
+    }
+    double scalar_time = seconds( start );
+    start = std::clock();
+    double scalar_balance = momentumBalance( scalar_events );
+    double check_time = seconds( start );
+    //........................................WHOLE EVENT
+    HepMC::ThreeVector zaxis( 0., 0., 1. );
+    start = std::clock();
+    for ( int pass = 0; pass < npass; ++pass ) {
+	for ( std::size_t i = 0; i < batch_events.size(); ++i ) {
+	    batch_events[i]->boost( beta );
+	    batch_events[i]->rotate( zaxis, angle );
+	    batch_events[i]->shift_vertices( dx );
+	}
+    }
+    double batch_time = seconds( start );
+    double batch_balance = momentumBalance( batch_events );
+    //........................................PRINT RESULT
+    std::cout << npass << " passes of boost + rotate + shift:" << std::endl;
+    std::cout << "  particle by particle: " << scalar_time << " s" << std::endl;
+    std::cout << "  whole event:          " << batch_time << " s" << std::endl;
+    std::cout << "  check_momentum_conservation over all vertices: "
+	      << check_time << " s" << std::endl;
+    std::cout << "Momentum balance after:  " << scalar_balance
+	      << " (particle by particle) " << batch_balance
+	      << " (whole event)" << std::endl;
+    for ( std::size_t i = 0; i < scalar_events.size(); ++i ) {
+	delete scalar_events[i];
+	delete batch_events[i];
+    }
+    return 0;
+}
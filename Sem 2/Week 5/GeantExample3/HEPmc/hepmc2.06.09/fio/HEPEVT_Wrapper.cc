@@ -10,6 +10,140 @@
 
 namespace HepMC {
 
+namespace {
+
+    // The common block type is only known at run time, so these
+    // helpers pick the storage type once per array rather than once
+    // per value as byte_num_to_int and byte_num_to_double do.
+
+    template <class T>
+    void copy_from_block( unsigned int byte, int n, int* out )
+    {
+	const T* in = (const T*)&hepevt.data[byte];
+	for ( int i = 0; i < n; ++i ) out[i] = (int)in[i];
+    }
+
+    template <class T>
+    void copy_from_block( unsigned int byte, int n, double* out )
+    {
+	const T* in = (const T*)&hepevt.data[byte];
+	for ( int i = 0; i < n; ++i ) out[i] = (double)in[i];
+    }
+
+    template <class T, class U>
+    void copy_to_block( const U* in, int n, unsigned int byte )
+    {
+	T* out = (T*)&hepevt.data[byte];
+	for ( int i = 0; i < n; ++i ) out[i] = (T)in[i];
+    }
+
+    bool read_ints( unsigned int byte, int n, int* out )
+    {
+	unsigned int size = HEPEVT_Wrapper::sizeof_int();
+	if ( size == sizeof(short int) ) {
+	    copy_from_block<short int>( byte, n, out );
+	} else if ( size == sizeof(long int) ) {
+	    copy_from_block<long int>( byte, n, out );
+	} else if ( size == sizeof(int) ) {
+	    copy_from_block<int>( byte, n, out );
+	} else {
+	    std::cerr << "HEPEVT_Wrapper: illegal integer number length." 
+		      << size << std::endl;
+	    return false;
+	}
+	return true;
+    }
+
+    bool read_reals( unsigned int byte, int n, double* out )
+    {
+	unsigned int size = HEPEVT_Wrapper::sizeof_real();
+	if ( size == sizeof(float) ) {
+	    copy_from_block<float>( byte, n, out );
+	} else if ( size == sizeof(double) ) {
+	    copy_from_block<double>( byte, n, out );
+	} else {
+	    std::cerr 
+		<< "HEPEVT_Wrapper: illegal floating point number length." 
+		<< size << std::endl;
+	    return false;
+	}
+	return true;
+    }
+
+    bool write_ints( const int* in, int n, unsigned int byte )
+    {
+	unsigned int size = HEPEVT_Wrapper::sizeof_int();
+	if ( size == sizeof(short int) ) {
+	    copy_to_block<short int>( in, n, byte );
+	} else if ( size == sizeof(long int) ) {
+	    copy_to_block<long int>( in, n, byte );
+	} else if ( size == sizeof(int) ) {
+	    copy_to_block<int>( in, n, byte );
+	} else {
+	    std::cerr << "HEPEVT_Wrapper: illegal integer number length." 
+		      << size << std::endl;
+	    return false;
+	}
+	return true;
+    }
+
+    bool write_reals( const double* in, int n, unsigned int byte )
+    {
+	unsigned int size = HEPEVT_Wrapper::sizeof_real();
+	if ( size == sizeof(float) ) {
+	    copy_to_block<float>( in, n, byte );
+	} else if ( size == sizeof(double) ) {
+	    copy_to_block<double>( in, n, byte );
+	} else {
+	    std::cerr 
+		<< "HEPEVT_Wrapper: illegal floating point number length." 
+		<< size << std::endl;
+	    return false;
+	}
+	return true;
+    }
+
+    bool block_fits()
+    {
+	unsigned int nmx = HEPEVT_Wrapper::max_number_entries();
+	unsigned int bytes = (2+6*nmx) * HEPEVT_Wrapper::sizeof_int()
+	                   + 9*nmx * HEPEVT_Wrapper::sizeof_real();
+	if ( bytes > hepevt_bytes_allocation ) {
+	    std::cerr 
+		<< "HEPEVT_Wrapper: requested hepevt data exceeds allocation"
+		<< std::endl;
+	    return false;
+	}
+	return true;
+    }
+
+    // same range checks as first_parent/last_parent and 
+    // first_child/last_child
+    void clean_pointers( std::vector<int>& j, int nhep )
+    {
+	for ( int i = 1; i <= nhep; ++i ) {
+	    int first = j[2*i];
+	    if ( first <= 0 || first > nhep ) first = 0;
+	    int last = j[2*i+1];
+	    if ( last <= first || last > nhep ) last = first;
+	    j[2*i] = first;
+	    j[2*i+1] = last;
+	}
+    }
+
+} // unnamed namespace
+
+    void HEPEVT_Arrays::resize( int n )
+    {
+	nhep = n;
+	isthep.resize( n+1 );
+	idhep.resize( n+1 );
+	jmohep.resize( 2*(n+1) );
+	jdahep.resize( 2*(n+1) );
+	phep.resize( 5*(n+1) );
+	vhep.resize( 4*(n+1) );
+    }
+
     ////////////////////////////////////////
     // static data member initializations //
     ////////////////////////////////////////
@@ -211,17 +345,56 @@ namespace HepMC {
 
     void HEPEVT_Wrapper::zero_everything()
     {
-	set_event_number( 0 );
-        set_number_entries( 0 );
-	for ( int i = 1; i<=max_number_entries(); ++i ) {
-	    set_status( i, 0 );
-	    set_id( i, 0 );
-	    set_parents( i, 0, 0 );
-	    set_children( i, 0, 0 );
-	    set_momentum( i, 0, 0, 0, 0 );
-	    set_mass( i, 0 );
-	    set_position( i, 0, 0, 0, 0 );
-	}
+	HEPEVT_Arrays a;
+	a.resize( max_number_entries() );
+	write_arrays( a );
+	set_number_entries( 0 );
+    }
+
+    bool HEPEVT_Wrapper::read_arrays( HEPEVT_Arrays& a )
+    {
+	/// The common block holds, in order, NEVHEP, NHEP, then the
+	/// ISTHEP, IDHEP, JMOHEP, and JDAHEP integer arrays and the
+	/// PHEP and VHEP real arrays, each sized for max_number_entries().
+	/// Each array is copied with one loop.
+	if ( !block_fits() ) return false;
+	const unsigned int nmx = max_number_entries();
+	const unsigned int isize = sizeof_int();
+	const unsigned int reals = (2+6*nmx) * isize;
+	int n = number_entries();
+	if ( n < 0 ) n = 0;
+	a.nevhep = event_number();
+	a.resize( n );
+	if ( n == 0 ) return true;
+	bool ok = read_ints( 2*isize, n, &a.isthep[1] )
+	       && read_ints( (2+nmx)*isize, n, &a.idhep[1] )
+	       && read_ints( (2+2*nmx)*isize, 2*n, &a.jmohep[2] )
+	       && read_ints( (2+4*nmx)*isize, 2*n, &a.jdahep[2] )
+	       && read_reals( reals, 5*n, &a.phep[5] )
+	       && read_reals( reals + 5*nmx*sizeof_real(), 4*n, &a.vhep[4] );
+	clean_pointers( a.jmohep, n );
+	clean_pointers( a.jdahep, n );
+	return ok;
+    }
+
+    bool HEPEVT_Wrapper::write_arrays( const HEPEVT_Arrays& a )
+    {
+	/// Inverse of read_arrays.  The pointers are written as given.
+	if ( !block_fits() ) return false;
+	const unsigned int nmx = max_number_entries();
+	const unsigned int isize = sizeof_int();
+	const unsigned int reals = (2+6*nmx) * isize;
+	int n = a.nhep < max_number_entries() ? a.nhep : max_number_entries();
+	if ( n < 0 ) n = 0;
+	set_event_number( a.nevhep );
+	set_number_entries( n );
+	if ( n <= 0 ) return true;
+	return write_ints( &a.isthep[1], n, 2*isize )
+	    && write_ints( &a.idhep[1], n, (2+nmx)*isize )
+	    && write_ints( &a.jmohep[2], 2*n, (2+2*nmx)*isize )
+	    && write_ints( &a.jdahep[2], 2*n, (2+4*nmx)*isize )
+	    && write_reals( &a.phep[5], 5*n, reals )
+	    && write_reals( &a.vhep[4], 4*n, reals + 5*nmx*sizeof_real() );
     }
 
 } // HepMC
@@ -50,19 +50,21 @@ namespace HepMC {
 		<< std::endl;
 	    return false;
 	}
-	evt->set_event_number( HEPEVT_Wrapper::event_number() );
+	// copy the whole common block in one pass, all further 
+	// lookups are plain array reads
+	if ( !HEPEVT_Wrapper::read_arrays( m_hepevt ) ) return false;
+	const int nhep = m_hepevt.nhep;
+	evt->set_event_number( m_hepevt.nevhep );
 	//
 	// 2. create a particle instance for each HEPEVT entry and fill a map
 	//    create a vector which maps from the HEPEVT particle index to the 
 	//    GenParticle address
 	//    (+1 in size accounts for hepevt_particle[0] which is unfilled)
-	std::vector<GenParticle*> hepevt_particle( 
-	                                HEPEVT_Wrapper::number_entries()+1 );
+	std::vector<GenParticle*> hepevt_particle( nhep+1 );
 	hepevt_particle[0] = 0;
-	for ( int i1 = 1; i1 <= HEPEVT_Wrapper::number_entries(); ++i1 ) {
+	for ( int i1 = 1; i1 <= nhep; ++i1 ) {
 	    hepevt_particle[i1] = build_particle(i1);
 	}
-	std::set<GenVertex*> new_vertices;
 	//
 	// Here we assume that the first two particles in the list 
 	// are the incoming beam particles.
@@ -71,7 +73,7 @@ namespace HepMC {
 	}
 	//
 	// 3.+4. loop over HEPEVT particles AGAIN, this time creating vertices
-	for ( int i = 1; i <= HEPEVT_Wrapper::number_entries(); ++i ) {
+	for ( int i = 1; i <= nhep; ++i ) {
 	    // We go through and build EITHER the production or decay 
 	    // vertex for each entry in hepevt, depending on the switch
 	    // m_trust_mothers_before_daughters (new 2001-02-28)
@@ -96,7 +98,7 @@ namespace HepMC {
 	//  i.e. particles without mothers or daughters.
 	//  These particles need to be attached to a vertex, or else they
 	//  will never become part of the event. check for this situation
-	for ( int i3 = 1; i3 <= HEPEVT_Wrapper::number_entries(); ++i3 ) {
+	for ( int i3 = 1; i3 <= nhep; ++i3 ) {
 	    if ( !hepevt_particle[i3]->end_vertex() && 
 			!hepevt_particle[i3]->production_vertex() ) {
 		GenVertex* prod_vtx = new GenVertex();
@@ -155,22 +157,31 @@ namespace HepMC {
 	    particle_counter = HEPEVT_Wrapper::max_number_entries();
 	}
 	// 	
-	// fill the HEPEVT event record
-	HEPEVT_Wrapper::set_event_number( evt->event_number() );
-	HEPEVT_Wrapper::set_number_entries( particle_counter );
+	// fill the HEPEVT event record locally, then copy it to the 
+	// common block in one pass
+	m_hepevt.resize( particle_counter );
+	m_hepevt.nevhep = evt->event_number();
 	for ( int i = 1; i <= particle_counter; ++i ) {
-	    HEPEVT_Wrapper::set_status( i, index_to_particle[i]->status() );
-	    HEPEVT_Wrapper::set_id( i, index_to_particle[i]->pdg_id() );
+	    m_hepevt.isthep[i] = index_to_particle[i]->status();
+	    m_hepevt.idhep[i] = index_to_particle[i]->pdg_id();
 	    FourVector m = index_to_particle[i]->momentum();
-	    HEPEVT_Wrapper::set_momentum( i, m.px(), m.py(), m.pz(), m.e() );
-	    HEPEVT_Wrapper::set_mass( i, index_to_particle[i]->generatedMass() );
+	    double* phep = &m_hepevt.phep[5*i];
+	    phep[0] = m.px();
+	    phep[1] = m.py();
+	    phep[2] = m.pz();
+	    phep[3] = m.e();
+	    phep[4] = index_to_particle[i]->generatedMass();
+	    double* vhep = &m_hepevt.vhep[4*i];
 	    // there should ALWAYS be particles in any vertex, but some generators
 	    // are making non-kosher HepMC events
 	    if ( index_to_particle[i]->production_vertex() && 
 	         index_to_particle[i]->production_vertex()->particles_in_size()) {
 		FourVector p = index_to_particle[i]->
 				     production_vertex()->position();
-		HEPEVT_Wrapper::set_position( i, p.x(), p.y(), p.z(), p.t() );
+		vhep[0] = p.x();
+		vhep[1] = p.y();
+		vhep[2] = p.z();
+		vhep[3] = p.t();
 		int num_mothers = index_to_particle[i]->production_vertex()->
 				  particles_in_size();
 		int first_mother = find_in_map( particle_to_index,
@@ -179,13 +190,15 @@ namespace HepMC {
 						  particles_in_const_begin()));
 		int last_mother = first_mother + num_mothers - 1;
 		if ( first_mother == 0 ) last_mother = 0;
-		HEPEVT_Wrapper::set_parents( i, first_mother, last_mother );
+		m_hepevt.jmohep[2*i] = first_mother;
+		m_hepevt.jmohep[2*i+1] = last_mother;
 	    } else {
-		HEPEVT_Wrapper::set_position( i, 0, 0, 0, 0 );
-		HEPEVT_Wrapper::set_parents( i, 0, 0 );
+		vhep[0] = vhep[1] = vhep[2] = vhep[3] = 0;
+		m_hepevt.jmohep[2*i] = m_hepevt.jmohep[2*i+1] = 0;
 	    }
-	    HEPEVT_Wrapper::set_children( i, 0, 0 );
+	    m_hepevt.jdahep[2*i] = m_hepevt.jdahep[2*i+1] = 0;
 	}
+	HEPEVT_Wrapper::write_arrays( m_hepevt );
     }
 
     void IO_HEPEVT::build_production_vertex(int i, 
@@ -197,21 +210,21 @@ namespace HepMC {
 	/// if appropriate, and add that vertex to the event
 	GenParticle* p = hepevt_particle[i];
 	// a. search to see if a production vertex already exists
-	int mother = HEPEVT_Wrapper::first_parent(i);
+	int mother = m_hepevt.first_parent(i);
 	GenVertex* prod_vtx = p->production_vertex();
 	while ( !prod_vtx && mother > 0 ) {
 	    prod_vtx = hepevt_particle[mother]->end_vertex();
 	    if ( prod_vtx ) prod_vtx->add_particle_out( p );
 	    // increment mother for next iteration
-	    if ( ++mother > HEPEVT_Wrapper::last_parent(i) ) mother = 0;
+	    if ( ++mother > m_hepevt.last_parent(i) ) mother = 0;
 	}
 	// b. if no suitable production vertex exists - and the particle
 	// has atleast one mother or position information to store - 
 	// make one
-	FourVector prod_pos( HEPEVT_Wrapper::x(i), HEPEVT_Wrapper::y(i), 
-				   HEPEVT_Wrapper::z(i), HEPEVT_Wrapper::t(i) 
+	FourVector prod_pos( m_hepevt.x(i), m_hepevt.y(i), 
+				   m_hepevt.z(i), m_hepevt.t(i) 
 	                         ); 
-	if ( !prod_vtx && (HEPEVT_Wrapper::number_parents(i)>0 
+	if ( !prod_vtx && (m_hepevt.number_parents(i)>0 
 			   || prod_pos!=FourVector(0,0,0,0)) )
 	{
 	    prod_vtx = new GenVertex();
@@ -224,7 +237,7 @@ namespace HepMC {
 	}
 	// d. loop over mothers to make sure their end_vertices are
 	//     consistent
-	mother = HEPEVT_Wrapper::first_parent(i);
+	mother = m_hepevt.first_parent(i);
 	while ( prod_vtx && mother > 0 ) {
 	    if ( !hepevt_particle[mother]->end_vertex() ) {
 		// if end vertex of the mother isn't specified, do it now
@@ -241,7 +254,7 @@ namespace HepMC {
 		if ( m_print_inconsistency_errors ) std::cerr
 		    << "HepMC::IO_HEPEVT: inconsistent mother/daugher "
 		    << "information in HEPEVT event " 
-		    << HEPEVT_Wrapper::event_number()
+		    << m_hepevt.nevhep
 		    << ". \n I recommend you try "
 		    << "inspecting the event first with "
 		    << "\n\tHEPEVT_Wrapper::check_hepevt_consistency()"
@@ -249,7 +262,7 @@ namespace HepMC {
 		    << "IO_HEPEVT::print_inconsistency_errors switch."
 		    << std::endl;
 	    }
-	    if ( ++mother > HEPEVT_Wrapper::last_parent(i) ) mother = 0;
+	    if ( ++mother > m_hepevt.last_parent(i) ) mother = 0;
 	}
     }
 
@@ -262,16 +275,16 @@ namespace HepMC {
 	//    Identical steps as for build_production_vertex
 	GenParticle* p = hepevt_particle[i];
 	// a.
-	int daughter = HEPEVT_Wrapper::first_child(i);
+	int daughter = m_hepevt.first_child(i);
 	GenVertex* end_vtx = p->end_vertex();
 	while ( !end_vtx && daughter > 0 ) {
 	    end_vtx = hepevt_particle[daughter]->production_vertex();
 	    if ( end_vtx ) end_vtx->add_particle_in( p );
-	    if ( ++daughter > HEPEVT_Wrapper::last_child(i) ) daughter = 0;
+	    if ( ++daughter > m_hepevt.last_child(i) ) daughter = 0;
 	}
 	// b. (different from 3c. because HEPEVT particle can not know its
 	//        decay position )
-	if ( !end_vtx && HEPEVT_Wrapper::number_children(i)>0 ) {
+	if ( !end_vtx && m_hepevt.number_children(i)>0 ) {
 	    end_vtx = new GenVertex();
 	    end_vtx->add_particle_in( p );
 	    evt->add_vertex( end_vtx );
@@ -279,7 +292,7 @@ namespace HepMC {
 	// c+d. loop over daughters to make sure their production vertices 
 	//    point back to the current vertex.
 	//    We get the vertex position from the daughter as well.
-	daughter = HEPEVT_Wrapper::first_child(i);
+	daughter = m_hepevt.first_child(i);
 	while ( end_vtx && daughter > 0 ) {
 	    if ( !hepevt_particle[daughter]->production_vertex() ) {
 		// if end vertex of the mother isn't specified, do it now
@@ -287,10 +300,10 @@ namespace HepMC {
 		// 
 		// 2001-03-29 M.Dobbs, fill vertex the position.
 		if ( end_vtx->position()==FourVector(0,0,0,0) ) {
-		    FourVector prod_pos( HEPEVT_Wrapper::x(daughter), 
-					       HEPEVT_Wrapper::y(daughter), 
-					       HEPEVT_Wrapper::z(daughter), 
-					       HEPEVT_Wrapper::t(daughter) 
+		    FourVector prod_pos( m_hepevt.x(daughter), 
+					       m_hepevt.y(daughter), 
+					       m_hepevt.z(daughter), 
+					       m_hepevt.t(daughter) 
 			);
 		    if ( prod_pos != FourVector(0,0,0,0) ) {
 			end_vtx->set_position( prod_pos );
@@ -306,7 +319,7 @@ namespace HepMC {
 		if ( m_print_inconsistency_errors ) std::cerr
 		    << "HepMC::IO_HEPEVT: inconsistent mother/daugher "
 		    << "information in HEPEVT event " 
-		    << HEPEVT_Wrapper::event_number()
+		    << m_hepevt.nevhep
 		    << ". \n I recommend you try "
 		    << "inspecting the event first with "
 		    << "\n\tHEPEVT_Wrapper::check_hepevt_consistency()"
@@ -314,7 +327,7 @@ namespace HepMC {
 		    << "IO_HEPEVT::print_inconsistency_errors switch."
 		    << std::endl;
 	    }
-	    if ( ++daughter > HEPEVT_Wrapper::last_child(i) ) daughter = 0;
+	    if ( ++daughter > m_hepevt.last_child(i) ) daughter = 0;
 	}
 	if ( !p->end_vertex() && !p->production_vertex() ) {
 	    // Added 2001-11-04, to try and handle Isajet problems.
@@ -326,13 +339,13 @@ namespace HepMC {
 	/// Builds a particle object corresponding to index in HEPEVT
 	// 
 	GenParticle* p 
-	    = new GenParticle( FourVector( HEPEVT_Wrapper::px(index), 
-						 HEPEVT_Wrapper::py(index), 
-						 HEPEVT_Wrapper::pz(index), 
-						 HEPEVT_Wrapper::e(index) ),
-			       HEPEVT_Wrapper::id(index), 
-			       HEPEVT_Wrapper::status(index) );
-        p->setGeneratedMass( HEPEVT_Wrapper::m(index) );
+	    = new GenParticle( FourVector( m_hepevt.px(index), 
+						 m_hepevt.py(index), 
+						 m_hepevt.pz(index), 
+						 m_hepevt.e(index) ),
+			       m_hepevt.idhep[index], 
+			       m_hepevt.isthep[index] );
+        p->setGeneratedMass( m_hepevt.m(index) );
 	p->suggest_barcode( index );
 	return p;
     }
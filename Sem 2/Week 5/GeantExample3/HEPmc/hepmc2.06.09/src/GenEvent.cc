@@ -613,6 +613,32 @@ namespace HepMC {
 	}
     }
 
+    void GenEvent::use_units( Units::MomentumUnit new_m, Units::LengthUnit new_l ) {
+	/// Converts momenta and positions in a single walk over the vertices.
+	/// Every particle is either outgoing from exactly one vertex or 
+	/// an orphan coming into one, so each is scaled exactly once.
+	const double mfactor = Units::conversion_factor( m_momentum_unit, new_m );
+	const double lfactor = Units::conversion_factor( m_position_unit, new_l );
+	m_momentum_unit = new_m;
+	m_position_unit = new_l;
+	if ( mfactor == 1. && lfactor == 1. ) return;
+	for ( GenEvent::vertex_iterator vtx = vertices_begin();
+	                                vtx != vertices_end(); ++vtx ) {
+	    if ( lfactor != 1. ) (*vtx)->convert_position(lfactor);
+	    if ( mfactor == 1. ) continue;
+	    for ( GenVertex::particles_out_const_iterator p 
+		      = (*vtx)->particles_out_const_begin();
+		  p != (*vtx)->particles_out_const_end(); ++p ) {
+		(*p)->convert_momentum(mfactor);
+	    }
+	    for ( GenVertex::particles_in_const_iterator p 
+		      = (*vtx)->particles_in_const_begin();
+		  p != (*vtx)->particles_in_const_end(); ++p ) {
+		if ( !(*p)->production_vertex() ) (*p)->convert_momentum(mfactor);
+	    }
+	}
+    }
+
    bool GenEvent::use_momentum_unit( Units::MomentumUnit newunit ) { 
 	// currently not exception-safe. 
 	// Easy to fix, though, if needed.
@@ -296,6 +296,19 @@ std::istream& GenEvent::read( std::istream& is )
 	               info.io_position_unit() );
     }
     //
+    // if the reader asked for specific units, convert while parsing
+    // the vertex and particle lines instead of converting afterwards
+    double momentum_factor = 1.;
+    double length_factor = 1.;
+    if( info.has_target_units() ) {
+        momentum_factor = Units::conversion_factor( momentum_unit(), 
+	                                   info.target_momentum_unit() );
+        length_factor = Units::conversion_factor( length_unit(), 
+	                                   info.target_position_unit() );
+	define_units( info.target_momentum_unit(), 
+	              info.target_position_unit() );
+    }
+    //
     // the end vertices of the particles are not connected until
     //  after the event is read --- we store the values in a map until then
     TempParticleMap particle_to_end_vertex;
@@ -304,7 +317,8 @@ std::istream& GenEvent::read( std::istream& is )
     for ( int iii = 1; iii <= num_vertices; ++iii ) {
 	GenVertex* v = new GenVertex();
 	try {
-	    detail::read_vertex(is,particle_to_end_vertex,v);
+	    detail::read_vertex(is,particle_to_end_vertex,v,
+	                        momentum_factor,length_factor);
 	}
 	catch (IO_Exception& e) {
 	    for( TempParticleMap::orderIterator it = particle_to_end_vertex.order_begin(); 
@@ -377,6 +391,16 @@ std::istream & set_input_units(std::istream & is,
     return is;
 }
 
+std::istream & set_target_units(std::istream & is, 
+                                Units::MomentumUnit mom,
+			        Units::LengthUnit len )
+{
+    //
+    StreamInfo & info = get_stream_info(is);
+    info.use_target_units( mom, len );
+    return is;
+}
+
 // ------------------------- begin and end block lines ----------------
 
 std::ostream & write_HepMC_IO_block_begin(std::ostream & os )
@@ -687,7 +711,8 @@ namespace detail {
 
 std::istream & read_particle( std::istream & is, 
                               TempParticleMap & particle_to_end_vertex, 
-			      GenParticle * p )
+			      GenParticle * p,
+			      double momentum_factor )
 {
     // get the next line
     std::string line;
@@ -745,6 +770,15 @@ std::istream & read_particle( std::istream & is,
         if(!iline) {  delete p; throw IO_Exception("read_particle input stream encounterd invalid data"); }
 	flow.set_icode( code_index,code);
     }
+    // apply any unit conversion here rather than in a second pass
+    // generated mass follows GenParticle::convert_momentum
+    if( momentum_factor != 1. ) {
+        px *= momentum_factor;
+        py *= momentum_factor;
+        pz *= momentum_factor;
+        e  *= momentum_factor;
+        if( m > 0. ) m *= momentum_factor;
+    }
     p->set_momentum( FourVector(px,py,pz,e) );
     p->set_pdg_id( id );
     p->set_status( status );
@@ -0,0 +1,108 @@
+//--------------------------------------------------------------------------
+//
+// GenEventTransforms.cc
+//
+// Whole-event Lorentz boosts, rotations, and vertex translations.
+// These are convenience calls, not a faster path: each four-vector is
+// transformed in place, as a loop over the particles would do.  The
+// particles and vertices are separate objects reached through the
+// barcode maps, so copying them into contiguous columns to vectorize
+// the arithmetic costs more than it saves.
+//
+// ----------------------------------------------------------------------
+
+#include <cmath>
+#include <iostream>
+
+#include "HepMC/GenEvent.h"
+
+namespace HepMC {
+
+namespace {
+
+    /// pure boost along (bx,by,bz), same convention as CLHEP
+    FourVector boosted( const FourVector& v, double bx, double by, double bz,
+                        double gamma, double gamma2 )
+    {
+	const double bp = bx*v.x() + by*v.y() + bz*v.z();
+	const double f = gamma2*bp + gamma*v.t();
+	return FourVector( v.x() + f*bx, v.y() + f*by, v.z() + f*bz,
+	                   gamma*( v.t() + bp ) );
+    }
+
+    /// apply the 3x3 matrix r (row major) to the spatial components
+    FourVector rotated( const FourVector& v, const double r[9] )
+    {
+	return FourVector( r[0]*v.x() + r[1]*v.y() + r[2]*v.z(),
+	                   r[3]*v.x() + r[4]*v.y() + r[5]*v.z(),
+	                   r[6]*v.x() + r[7]*v.y() + r[8]*v.z(),
+	                   v.t() );
+    }
+
+} // unnamed namespace
+
+bool GenEvent::boost( const ThreeVector& beta )
+{
+    /// Boosts every particle momentum and every vertex position
+    /// (whose 4th component is ctau) by the velocity beta.
+    /// Returns false and leaves the event untouched if |beta| >= 1.
+    const double b2 = beta.x()*beta.x() + beta.y()*beta.y() + beta.z()*beta.z();
+    if ( b2 >= 1.0 ) {
+	std::cerr << "GenEvent::boost ERROR: |beta| = " << std::sqrt(b2)
+		  << " is not less than 1, event not boosted" << std::endl;
+	return false;
+    }
+    if ( b2 == 0 ) return true;
+    const double bx = beta.x(), by = beta.y(), bz = beta.z();
+    const double gamma = 1.0 / std::sqrt( 1.0 - b2 );
+    const double gamma2 = (gamma - 1.0)/b2;
+    for ( particle_iterator p = particles_begin(); p != particles_end(); ++p ) {
+	(*p)->set_momentum( boosted( (*p)->momentum(), bx, by, bz, gamma, gamma2 ) );
+    }
+    for ( vertex_iterator v = vertices_begin(); v != vertices_end(); ++v ) {
+	(*v)->set_position( boosted( (*v)->position(), bx, by, bz, gamma, gamma2 ) );
+    }
+    return true;
+}
+
+bool GenEvent::rotate( const ThreeVector& axis, double angle )
+{
+    /// Rotates every particle momentum and every vertex position
+    /// by angle (radians, right-handed) about axis.
+    /// Returns false and leaves the event untouched if axis is null.
+    const double len = axis.r();
+    if ( len == 0 ) {
+	std::cerr << "GenEvent::rotate ERROR: null rotation axis, "
+		  << "event not rotated" << std::endl;
+	return false;
+    }
+    const double ux = axis.x()/len, uy = axis.y()/len, uz = axis.z()/len;
+    const double c = std::cos(angle);
+    const double s = std::sin(angle);
+    const double oc = 1.0 - c;
+    // Rodrigues rotation matrix
+    const double r[9] = { c + ux*ux*oc,    ux*uy*oc - uz*s, ux*uz*oc + uy*s,
+                          uy*ux*oc + uz*s, c + uy*uy*oc,    uy*uz*oc - ux*s,
+                          uz*ux*oc - uy*s, uz*uy*oc + ux*s, c + uz*uz*oc };
+
+    for ( particle_iterator p = particles_begin(); p != particles_end(); ++p ) {
+	(*p)->set_momentum( rotated( (*p)->momentum(), r ) );
+    }
+    for ( vertex_iterator v = vertices_begin(); v != vertices_end(); ++v ) {
+	(*v)->set_position( rotated( (*v)->position(), r ) );
+    }
+    return true;
+}
+
+void GenEvent::shift_vertices( const FourVector& dx )
+{
+    /// Translates every vertex position by dx, given in the length
+    /// units of this event.  Momenta are not changed.
+    for ( vertex_iterator v = vertices_begin(); v != vertices_end(); ++v ) {
+	const FourVector& x = (*v)->position();
+	(*v)->set_position( FourVector( x.x() + dx.x(), x.y() + dx.y(),
+	                                x.z() + dx.z(), x.t() + dx.t() ) );
+    }
+}
+
+} // HepMC
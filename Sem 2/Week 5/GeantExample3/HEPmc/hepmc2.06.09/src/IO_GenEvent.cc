@@ -83,6 +83,13 @@ namespace HepMC {
 	}
     }
 
+    void IO_GenEvent::use_target_units( Units::MomentumUnit mom, 
+                                        Units::LengthUnit len ) {
+        if( m_istr != NULL ) {
+            set_target_units( *m_istr, mom, len );
+	}
+    }
+
     void IO_GenEvent::print( std::ostream& ostr ) const { 
 	ostr << "IO_GenEvent: unformated ascii file IO for machine reading.\n"; 
 	if(m_have_file)    ostr  << "\tFile openmode: " << m_mode ;
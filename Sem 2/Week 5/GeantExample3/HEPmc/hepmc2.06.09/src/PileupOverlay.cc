@@ -0,0 +1,310 @@
+//--------------------------------------------------------------------------
+//
+// PileupOverlay.cc
+//
+// ----------------------------------------------------------------------
+
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include "HepMC/PileupOverlay.h"
+#include "HepMC/Units.h"
+
+namespace HepMC {
+
+//////////////////////////////////////////////////////////////////////////
+// PileupOverlay
+//////////////////////////////////////////////////////////////////////////
+
+PileupOverlay::PileupOverlay( int barcode_stride )
+  : m_stride( barcode_stride > 0 ? barcode_stride : 1000000 ),
+    m_smear(false),
+    m_smear_signal(false),
+    m_seed(1),
+    m_has_spare(false),
+    m_spare(0)
+{
+    m_sigma[0] = m_sigma[1] = m_sigma[2] = m_sigma[3] = 0;
+}
+
+int PileupOverlay::max_sub_events() const
+{
+    return INT_MAX / m_stride;
+}
+
+int PileupOverlay::sub_event( int barcode ) const
+{
+    return std::abs(barcode) / m_stride;
+}
+
+void PileupOverlay::set_vertex_smearing( double sigma_x, double sigma_y,
+                                         double sigma_z, double sigma_t )
+{
+    m_sigma[0] = sigma_x;
+    m_sigma[1] = sigma_y;
+    m_sigma[2] = sigma_z;
+    m_sigma[3] = sigma_t;
+    m_smear = sigma_x != 0 || sigma_y != 0 || sigma_z != 0 || sigma_t != 0;
+}
+
+void PileupOverlay::set_seed( long seed )
+{
+    /// any seed is accepted, it is folded into the generator range
+    m_seed = std::labs( seed ) % 2147483647L;
+    if ( m_seed == 0 ) m_seed = 1;
+    m_has_spare = false;
+}
+
+double PileupOverlay::uniform()
+{
+    // Park and Miller minimal standard generator, using Schrage's
+    // method so that nothing overflows a 32 bit long
+    const long a = 16807, m = 2147483647L, q = 127773, r = 2836;
+    long hi = m_seed / q;
+    long lo = m_seed % q;
+    m_seed = a*lo - r*hi;
+    if ( m_seed <= 0 ) m_seed += m;
+    return m_seed / double(m);
+}
+
+double PileupOverlay::gauss()
+{
+    // Box-Muller, the second number is kept for the next call
+    if ( m_has_spare ) {
+	m_has_spare = false;
+	return m_spare;
+    }
+    const double twopi = 6.28318530717958647692;
+    double rho = std::sqrt( -2.0*std::log( uniform() ) );
+    double phi = twopi*uniform();
+    m_spare = rho*std::sin(phi);
+    m_has_spare = true;
+    return rho*std::cos(phi);
+}
+
+bool PileupOverlay::fits( const GenEvent& in ) const
+{
+    for ( GenEvent::particle_const_iterator p = in.particles_begin();
+	  p != in.particles_end(); ++p ) {
+	if ( (*p)->barcode() >= m_stride ) return false;
+    }
+    for ( GenEvent::vertex_const_iterator v = in.vertices_begin();
+	  v != in.vertices_end(); ++v ) {
+	if ( -(*v)->barcode() >= m_stride ) return false;
+    }
+    return true;
+}
+
+GenEvent* PileupOverlay::overlay( const GenEvent& signal,
+                                  const std::vector<const GenEvent*>& pileup )
+{
+    /// The particles and vertices of each sub-event are linked
+    /// together before the vertices are added to the merged event,
+    /// and every barcode is free, so each particle and vertex is
+    /// entered in the barcode maps exactly once.
+    if ( (int)pileup.size() >= max_sub_events() ) {
+	std::cerr << "PileupOverlay::overlay ERROR: " << pileup.size()+1
+		  << " sub-events do not fit with barcode stride "
+		  << m_stride << std::endl;
+	return 0;
+    }
+    bool ok = fits( signal );
+    for ( std::size_t k = 0; ok && k < pileup.size(); ++k ) {
+	ok = pileup[k] && fits( *pileup[k] );
+    }
+    if ( !ok ) {
+	std::cerr << "PileupOverlay::overlay ERROR: an input event has a "
+		  << "barcode outside the stride " << m_stride
+		  << ", nothing merged" << std::endl;
+	return 0;
+    }
+
+    GenEvent* out = new GenEvent( signal.momentum_unit(),
+                                  signal.length_unit(),
+                                  signal.signal_process_id(),
+                                  signal.event_number(), 0,
+                                  signal.weights(),
+                                  signal.random_states() );
+    out->set_mpi( signal.mpi() );
+    out->set_event_scale( signal.event_scale() );
+    out->set_alphaQCD( signal.alphaQCD() );
+    out->set_alphaQED( signal.alphaQED() );
+    if ( signal.cross_section() ) out->set_cross_section( *signal.cross_section() );
+    if ( signal.heavy_ion() ) out->set_heavy_ion( *signal.heavy_ion() );
+    if ( signal.pdf_info() ) out->set_pdf_info( *signal.pdf_info() );
+
+    add_sub_event( signal, 0, *out );
+    for ( std::size_t k = 0; k < pileup.size(); ++k ) {
+	add_sub_event( *pileup[k], k+1, *out );
+    }
+    return out;
+}
+
+void PileupOverlay::add_sub_event( const GenEvent& in, int k, GenEvent& out )
+{
+    const int offset = k*m_stride;
+    const double mom = Units::conversion_factor( in.momentum_unit(),
+                                                 out.momentum_unit() );
+    const double len = Units::conversion_factor( in.length_unit(),
+                                                 out.length_unit() );
+    FourVector shift( 0, 0, 0, 0 );
+    if ( m_smear && ( k > 0 || m_smear_signal ) ) {
+	shift = FourVector( m_sigma[0]*gauss(), m_sigma[1]*gauss(),
+	                    m_sigma[2]*gauss(), m_sigma[3]*gauss() );
+    }
+
+    // 1. copy the vertices, indexed by their old barcode
+    std::vector<GenVertex*> new_vertices;
+    new_vertices.reserve( in.vertices_size() );
+    for ( GenEvent::vertex_const_iterator v = in.vertices_begin();
+	  v != in.vertices_end(); ++v ) {
+	const FourVector& x = (*v)->position();
+	GenVertex* nv = new GenVertex( FourVector( len*x.x() + shift.x(),
+	                                           len*x.y() + shift.y(),
+	                                           len*x.z() + shift.z(),
+	                                           len*x.t() + shift.t() ),
+	                               (*v)->id(), (*v)->weights() );
+	nv->suggest_barcode( (*v)->barcode() - offset );
+	std::size_t index = -(*v)->barcode();
+	if ( m_vertex_lookup.size() <= index ) m_vertex_lookup.resize( index+1, 0 );
+	m_vertex_lookup[index] = nv;
+	new_vertices.push_back( nv );
+    }
+
+    // 2. copy the particles and attach them to the new vertices
+    GenParticle* beam1 = 0;
+    GenParticle* beam2 = 0;
+    std::pair<GenParticle*,GenParticle*> beams = in.beam_particles();
+    for ( GenEvent::particle_const_iterator p = in.particles_begin();
+	  p != in.particles_end(); ++p ) {
+	GenParticle* np = new GenParticle( **p );
+	np->suggest_barcode( (*p)->barcode() + offset );
+	if ( mom != 1.0 ) {
+	    const FourVector& m = (*p)->momentum();
+	    np->set_momentum( FourVector( mom*m.px(), mom*m.py(),
+	                                  mom*m.pz(), mom*m.e() ) );
+	    np->set_generated_mass( mom*(*p)->generated_mass() );
+	}
+	if ( (*p)->end_vertex() ) {
+	    m_vertex_lookup[ -(*p)->end_vertex()->barcode() ]->add_particle_in( np );
+	}
+	if ( (*p)->production_vertex() ) {
+	    m_vertex_lookup[ -(*p)->production_vertex()->barcode() ]->add_particle_out( np );
+	}
+	if ( *p == beams.first ) beam1 = np;
+	if ( *p == beams.second ) beam2 = np;
+    }
+
+    // 3. hand the finished sub-event to the merged event
+    for ( std::size_t i = 0; i < new_vertices.size(); ++i ) {
+	out.add_vertex( new_vertices[i] );
+    }
+    if ( k == 0 ) {
+	if ( in.signal_process_vertex() ) {
+	    out.set_signal_process_vertex(
+	        m_vertex_lookup[ -in.signal_process_vertex()->barcode() ] );
+	}
+	if ( beam1 || beam2 ) out.set_beam_particles( beam1, beam2 );
+    }
+    for ( GenEvent::vertex_const_iterator v = in.vertices_begin();
+	  v != in.vertices_end(); ++v ) {
+	m_vertex_lookup[ -(*v)->barcode() ] = 0;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// PileupLibrary
+//////////////////////////////////////////////////////////////////////////
+
+PileupLibrary::PileupLibrary( const std::string& filename,
+                              std::size_t cache_size )
+  : m_file( filename.c_str() ),
+    m_cache_size( cache_size > 0 ? cache_size : 1 ),
+    m_next(0),
+    m_parsed(0)
+{
+    if ( !m_file ) {
+	std::cerr << "PileupLibrary: cannot open " << filename << std::endl;
+	return;
+    }
+    // 1. find the start of every event without parsing it
+    std::ifstream scan( filename.c_str() );
+    std::string line;
+    std::streampos pos = scan.tellg();
+    while ( std::getline( scan, line ) ) {
+	if ( line.size() > 1 && line[0] == 'E' && line[1] == ' ' ) {
+	    m_offsets.push_back( pos );
+	}
+	pos = scan.tellg();
+    }
+    if ( m_offsets.empty() ) {
+	std::cerr << "PileupLibrary: no events in " << filename << std::endl;
+	return;
+    }
+    // 2. the first read goes through the file header, which sets up
+    //    the input format for all later reads
+    GenEvent* evt = new GenEvent();
+    evt->read( m_file );
+    ++m_parsed;
+    if ( !m_file || !evt->is_valid() ) {
+	std::cerr << "PileupLibrary: cannot read " << filename << std::endl;
+	delete evt;
+	m_offsets.clear();
+	return;
+    }
+    m_cache[0] = evt;
+    m_cache_order.push_back( 0 );
+}
+
+PileupLibrary::~PileupLibrary()
+{
+    for ( std::map<std::size_t,GenEvent*>::iterator c = m_cache.begin();
+	  c != m_cache.end(); ++c ) {
+	delete c->second;
+    }
+}
+
+const GenEvent* PileupLibrary::event( std::size_t i )
+{
+    if ( i >= m_offsets.size() ) return 0;
+    std::map<std::size_t,GenEvent*>::iterator c = m_cache.find( i );
+    if ( c != m_cache.end() ) return c->second;
+
+    GenEvent* evt = new GenEvent();
+    m_file.clear();
+    m_file.seekg( m_offsets[i] );
+    evt->read( m_file );
+    ++m_parsed;
+    if ( m_file.bad() || !evt->is_valid() ) {
+	std::cerr << "PileupLibrary: cannot read event " << i << std::endl;
+	delete evt;
+	return 0;
+    }
+    while ( m_cache_order.size() >= m_cache_size ) {
+	std::map<std::size_t,GenEvent*>::iterator old
+	    = m_cache.find( m_cache_order.front() );
+	delete old->second;
+	m_cache.erase( old );
+	m_cache_order.pop_front();
+    }
+    m_cache[i] = evt;
+    m_cache_order.push_back( i );
+    return evt;
+}
+
+void PileupLibrary::next_events( std::size_t n, std::vector<const GenEvent*>& v )
+{
+    v.clear();
+    if ( m_offsets.empty() ) return;
+    if ( m_cache_size < n ) m_cache_size = n;
+    v.reserve( n );
+    for ( std::size_t k = 0; k < n; ++k ) {
+	const GenEvent* evt = event( m_next );
+	if ( evt ) v.push_back( evt );
+	if ( ++m_next == m_offsets.size() ) m_next = 0;
+    }
+}
+
+} // HepMC
@@ -22,7 +22,9 @@ namespace detail {
 
 std::istream & read_vertex( std::istream & is, 
                             TempParticleMap & particle_to_end_vertex, 
-			    GenVertex * v )
+			    GenVertex * v,
+			    double momentum_factor,
+			    double length_factor )
 {
     //
     // make sure the stream is valid
@@ -74,6 +76,13 @@ std::istream & read_vertex( std::istream & is,
         iline >> weights[i1];
         if(!iline) { throw IO_Exception("read_vertex input stream encounterd invalid data"); }
     }
+    // apply any unit conversion here rather than in a second pass
+    if( length_factor != 1. ) {
+        x *= length_factor;
+        y *= length_factor;
+        z *= length_factor;
+        t *= length_factor;
+    }
     v->set_position( FourVector(x,y,z,t) );
     v->set_id( id );
     v->weights() = weights;
@@ -84,11 +93,11 @@ std::istream & read_vertex( std::istream & is,
     //  particles are added to a map and handled later.
     for ( int i2 = 1; i2 <= num_orphans_in; ++i2 ) {
         GenParticle* p1 = new GenParticle( ); 
-	detail::read_particle(is,particle_to_end_vertex,p1);
+	detail::read_particle(is,particle_to_end_vertex,p1,momentum_factor);
     }
     for ( int i3 = 1; i3 <= num_particles_out; ++i3 ) {
         GenParticle* p2 = new GenParticle( ); 
-	detail::read_particle(is,particle_to_end_vertex,p2);
+	detail::read_particle(is,particle_to_end_vertex,p2,momentum_factor);
 	v->add_particle_out( p2 );
     }
 
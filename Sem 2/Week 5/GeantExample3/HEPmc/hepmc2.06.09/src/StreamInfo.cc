@@ -26,6 +26,9 @@ StreamInfo::StreamInfo( )
   m_has_key(true),
   m_io_momentum_unit(Units::default_momentum_unit()),
   m_io_position_unit(Units::default_length_unit()),
+  m_has_target_units(false),
+  m_target_momentum_unit(Units::default_momentum_unit()),
+  m_target_position_unit(Units::default_length_unit()),
   m_stream_id(m_stream_counter),
   m_reading_event_header(false)
 {
@@ -40,6 +43,12 @@ void StreamInfo::use_input_units( Units::MomentumUnit mom, Units::LengthUnit len
     m_io_position_unit = len;
 }
 
+void StreamInfo::use_target_units( Units::MomentumUnit mom, Units::LengthUnit len ) {
+    m_has_target_units = true;
+    m_target_momentum_unit = mom;
+    m_target_position_unit = len;
+}
+
 void StreamInfo::set_io_type( int io ) {
     m_io_type = io;
 }
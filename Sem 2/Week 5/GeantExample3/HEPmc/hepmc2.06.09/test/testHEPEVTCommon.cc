@@ -0,0 +1,20 @@
+//////////////////////////////////////////////////////////////////////////
+// testHEPEVTCommon.cc
+//
+// The HEPEVT common block that a fortran generator would provide,
+// for the tests of HEPEVT_Wrapper.
+// It is sized as hepevt_bytes_allocation in HepMC/HEPEVT_Wrapper.h,
+// which is not included here: its declaration of hepevt_ has a
+// different (unnamed) type.
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef HEPEVT_EntriesAllocation
+#define HEPEVT_EntriesAllocation 10000
+#endif  // HEPEVT_EntriesAllocation
+
+extern "C" {
+    struct {
+	char data[ sizeof(long int) * ( 2 + 6 * HEPEVT_EntriesAllocation )
+	           + sizeof(double) * ( 9 * HEPEVT_EntriesAllocation ) ];
+    } hepevt_;
+}
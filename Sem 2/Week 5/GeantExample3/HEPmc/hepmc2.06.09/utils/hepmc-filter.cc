@@ -0,0 +1,549 @@
+//////////////////////////////////////////////////////////////////////////
+// hepmc-filter
+//
+// Stream an IO_GenEvent file through a set of event and particle
+// selections and write the events that pass to a new IO_GenEvent file.
+//
+// The main thread splits the input into the text of single events and
+// writes the results in input order.  Worker threads parse and filter
+// the events.  At most a fixed window of events is held in memory,
+// whatever the size of the input.
+//
+// Run hepmc-filter --help for the list of selections.
+//////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <pthread.h>
+#include <sys/time.h>
+
+#include "HepMC/GenEvent.h"
+#include "HepMC/IO_GenEvent.h"
+
+namespace {
+
+//////////////////////////////////////////////////////////////////////////
+// selections
+//////////////////////////////////////////////////////////////////////////
+
+/// Event and particle selections given on the command line.
+/// Read only once the workers are started.
+struct Selection {
+    std::vector<int> process_ids;   // keep events with one of these ids
+    std::vector<int> required_pdg;  // each |id| must be among the kept particles
+    std::vector<int> statuses;      // keep particles with one of these
+    std::vector<int> pdg_ids;       // keep particles with one of these |id|
+    double pt_min;
+    double eta_max;
+    double e_min;
+    int    min_particles;
+    bool   slim;                    // true if any particle selection is set
+
+    Selection() : pt_min(-1.), eta_max(-1.), e_min(-1.),
+                  min_particles(0), slim(false) {}
+
+    bool keep_particle( const HepMC::GenParticle* p ) const;
+    bool keep_event( const HepMC::GenEvent* evt ) const;
+};
+
+bool contains( const std::vector<int>& v, int i )
+{
+    for ( std::size_t k = 0; k < v.size(); ++k ) {
+	if ( v[k] == i ) return true;
+    }
+    return false;
+}
+
+bool Selection::keep_particle( const HepMC::GenParticle* p ) const
+{
+    if ( !statuses.empty() && !contains( statuses, p->status() ) ) return false;
+    if ( !pdg_ids.empty() && !contains( pdg_ids, std::abs(p->pdg_id()) ) ) return false;
+    const HepMC::FourVector& m = p->momentum();
+    if ( pt_min >= 0 && m.perp() < pt_min ) return false;
+    if ( e_min >= 0 && m.e() < e_min ) return false;
+    if ( eta_max >= 0 ) {
+	// particles along the beam have no finite eta
+	if ( m.perp() == 0 || std::fabs( m.eta() ) > eta_max ) return false;
+    }
+    return true;
+}
+
+bool Selection::keep_event( const HepMC::GenEvent* evt ) const
+{
+    /// evt is the event after any particle selection
+    if ( !process_ids.empty()
+         && !contains( process_ids, evt->signal_process_id() ) ) return false;
+    if ( evt->particles_size() < min_particles ) return false;
+    for ( std::size_t k = 0; k < required_pdg.size(); ++k ) {
+	bool found = false;
+	for ( HepMC::GenEvent::particle_const_iterator p = evt->particles_begin();
+	      p != evt->particles_end() && !found; ++p ) {
+	    found = std::abs( (*p)->pdg_id() ) == required_pdg[k];
+	}
+	if ( !found ) return false;
+    }
+    return true;
+}
+
+/// Copy of evt holding only the particles that pass sel.
+/// Barcodes, production vertex positions, and the event level
+/// information are kept.  Each kept particle becomes an outgoing
+/// particle of a copy of its production vertex.  The signal process
+/// vertex and the beam particles are set when they survive: the signal
+/// vertex if a kept particle comes out of it, a beam particle if it
+/// passes the selection.
+HepMC::GenEvent* slim_event( const HepMC::GenEvent* evt, const Selection& sel )
+{
+    HepMC::GenEvent* out = new HepMC::GenEvent( evt->momentum_unit(),
+                                                evt->length_unit(),
+                                                evt->signal_process_id(),
+						evt->event_number(), 0,
+						evt->weights(),
+						evt->random_states() );
+    out->set_mpi( evt->mpi() );
+    out->set_event_scale( evt->event_scale() );
+    out->set_alphaQCD( evt->alphaQCD() );
+    out->set_alphaQED( evt->alphaQED() );
+    if ( evt->cross_section() ) out->set_cross_section( *evt->cross_section() );
+    if ( evt->heavy_ion() ) out->set_heavy_ion( *evt->heavy_ion() );
+    if ( evt->pdf_info() ) out->set_pdf_info( *evt->pdf_info() );
+
+    std::map<int,HepMC::GenVertex*> vertex_copy;
+    std::pair<HepMC::GenParticle*,HepMC::GenParticle*> beams = evt->beam_particles();
+    HepMC::GenParticle* beam1 = 0;
+    HepMC::GenParticle* beam2 = 0;
+    for ( HepMC::GenEvent::particle_const_iterator p = evt->particles_begin();
+	  p != evt->particles_end(); ++p ) {
+	if ( !sel.keep_particle( *p ) ) continue;
+	const HepMC::GenVertex* orig = (*p)->production_vertex();
+	int vbc = orig ? orig->barcode() : 0;
+	HepMC::GenVertex*& v = vertex_copy[vbc];
+	if ( !v ) {
+	    v = orig ? new HepMC::GenVertex( orig->position(), orig->id(),
+	                                     orig->weights() )
+	             : new HepMC::GenVertex();
+	    if ( orig ) v->suggest_barcode( vbc );
+	}
+	HepMC::GenParticle* copy = new HepMC::GenParticle( **p );
+	copy->suggest_barcode( (*p)->barcode() );
+	v->add_particle_out( copy );
+	if ( *p == beams.first ) beam1 = copy;
+	if ( *p == beams.second ) beam2 = copy;
+    }
+    // the map puts the vertex of the particles without a production
+    // vertex (key 0) last, so its new barcode can't take an original one
+    for ( std::map<int,HepMC::GenVertex*>::const_iterator v = vertex_copy.begin();
+	  v != vertex_copy.end(); ++v ) {
+	out->add_vertex( v->second );
+    }
+    const HepMC::GenVertex* signal = evt->signal_process_vertex();
+    if ( signal ) {
+	std::map<int,HepMC::GenVertex*>::const_iterator s
+	    = vertex_copy.find( signal->barcode() );
+	if ( s != vertex_copy.end() ) out->set_signal_process_vertex( s->second );
+    }
+    if ( beam1 || beam2 ) out->set_beam_particles( beam1, beam2 );
+    return out;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// input splitting
+//////////////////////////////////////////////////////////////////////////
+
+/// Splits an IO_GenEvent stream into the text of single events.
+class EventSplitter {
+public:
+    explicit EventSplitter( std::istream& is )
+      : m_is(is), m_bytes(0), m_ok(true) {}
+
+    /// put the text of the next event in text, false at the end
+    bool next( std::string& text );
+    /// the START_EVENT_LISTING line of the input
+    const std::string& start_key() const { return m_start_key; }
+    double bytes_read() const { return m_bytes; }
+    bool ok() const { return m_ok; }
+
+private:
+    bool get_line( std::string& line );
+
+    std::istream& m_is;
+    std::string   m_start_key;
+    std::string   m_pending;    // E line already read for the next event
+    double        m_bytes;
+    bool          m_ok;
+};
+
+bool EventSplitter::get_line( std::string& line )
+{
+    if ( !std::getline( m_is, line ) ) return false;
+    m_bytes += line.size() + 1;
+    return true;
+}
+
+bool EventSplitter::next( std::string& text )
+{
+    text.clear();
+    std::string line;
+    if ( !m_pending.empty() ) {
+	text = m_pending;
+	text += '\n';
+	m_pending.clear();
+    }
+    while ( get_line( line ) ) {
+	if ( line.compare( 0, 7, "HepMC::" ) == 0 ) {
+	    if ( line.find( "-START_EVENT_LISTING" ) != std::string::npos ) {
+		if ( m_start_key.empty() ) {
+		    m_start_key = line;
+		} else if ( line != m_start_key ) {
+		    std::cerr << "hepmc-filter: mixed input formats are not "
+		              << "supported: " << line << std::endl;
+		    m_ok = false;
+		    return false;
+		}
+	    } else if ( line.find( "-END_EVENT_LISTING" ) != std::string::npos ) {
+		if ( !text.empty() ) return true;
+	    }
+	    continue;
+	}
+	if ( m_start_key.empty() || line.empty() ) continue;
+	if ( line.size() > 1 && line[0] == 'E' && line[1] == ' '
+	     && !text.empty() ) {
+	    m_pending = line;
+	    return true;
+	}
+	if ( text.empty() && line[0] != 'E' ) continue;
+	text += line;
+	text += '\n';
+    }
+    return !text.empty();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// thread pool with an ordered window
+//////////////////////////////////////////////////////////////////////////
+
+/// one event in flight
+struct Slot {
+    std::string      text;
+    HepMC::GenEvent* result;
+    bool             done;
+    bool             error;
+    Slot() : result(0), done(false), error(false) {}
+};
+
+struct Pipeline {
+    const Selection*  sel;
+    std::string       start_key;
+    std::vector<Slot> slots;
+    std::vector<long> queue;      // sequence numbers waiting for a worker
+    std::size_t       queue_head;
+    bool              stop;
+    pthread_mutex_t   mutex;
+    pthread_cond_t    work_ready;
+    pthread_cond_t    slot_done;
+    // StreamInfo registration on a new stream is not thread safe,
+    // so the first read on each worker stream is serialised
+    pthread_mutex_t   stream_setup;
+
+    explicit Pipeline( std::size_t window )
+      : sel(0), slots(window), queue_head(0), stop(false)
+    {
+	pthread_mutex_init( &mutex, 0 );
+	pthread_mutex_init( &stream_setup, 0 );
+	pthread_cond_init( &work_ready, 0 );
+	pthread_cond_init( &slot_done, 0 );
+    }
+    ~Pipeline()
+    {
+	pthread_cond_destroy( &slot_done );
+	pthread_cond_destroy( &work_ready );
+	pthread_mutex_destroy( &stream_setup );
+	pthread_mutex_destroy( &mutex );
+    }
+    Slot& slot( long seq ) { return slots[ seq % slots.size() ]; }
+};
+
+void* worker( void* arg )
+{
+    Pipeline& pl = *static_cast<Pipeline*>(arg);
+    std::istringstream is;
+    bool first = true;
+    for (;;) {
+	pthread_mutex_lock( &pl.mutex );
+	while ( pl.queue_head == pl.queue.size() && !pl.stop ) {
+	    pthread_cond_wait( &pl.work_ready, &pl.mutex );
+	}
+	if ( pl.queue_head == pl.queue.size() ) {
+	    pthread_mutex_unlock( &pl.mutex );
+	    break;
+	}
+	long seq = pl.queue[pl.queue_head++];
+	if ( pl.queue_head == pl.queue.size() ) {
+	    pl.queue.clear();
+	    pl.queue_head = 0;
+	}
+	Slot& s = pl.slot( seq );
+	pthread_mutex_unlock( &pl.mutex );
+
+	// the stream remembers the input format after the first event
+	is.clear();
+	if ( first ) {
+	    is.str( pl.start_key + "\n" + s.text );
+	} else {
+	    is.str( s.text );
+	}
+	std::string().swap( s.text );
+	HepMC::GenEvent* evt = new HepMC::GenEvent();
+	if ( first ) {
+	    pthread_mutex_lock( &pl.stream_setup );
+	    evt->read( is );
+	    pthread_mutex_unlock( &pl.stream_setup );
+	    first = false;
+	} else {
+	    evt->read( is );
+	}
+	bool error = is.bad() || !evt->is_valid();
+	if ( !error && pl.sel->slim ) {
+	    HepMC::GenEvent* slim = slim_event( evt, *pl.sel );
+	    delete evt;
+	    evt = slim;
+	}
+	if ( error || !pl.sel->keep_event( evt ) ) {
+	    delete evt;
+	    evt = 0;
+	}
+
+	pthread_mutex_lock( &pl.mutex );
+	s.result = evt;
+	s.error = error;
+	s.done = true;
+	pthread_cond_broadcast( &pl.slot_done );
+	pthread_mutex_unlock( &pl.mutex );
+    }
+    return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// command line
+//////////////////////////////////////////////////////////////////////////
+
+double now()
+{
+    timeval tv;
+    gettimeofday( &tv, 0 );
+    return tv.tv_sec + 1.e-6*tv.tv_usec;
+}
+
+void usage( std::ostream& os )
+{
+    os << "usage: hepmc-filter [options] input output\n"
+       << "  input and output are IO_GenEvent files, - means stdin/stdout\n"
+       << "\n"
+       << "event selection:\n"
+       << "  --skip N           skip the first N events of the input\n"
+       << "  --count N          read at most N events after the skipped ones\n"
+       << "  --process ID       keep events with this signal_process_id\n"
+       << "  --require-pdg ID   keep events with a particle of |pdg_id| ID\n"
+       << "  --min-particles N  keep events with at least N particles\n"
+       << "particle selection (the event is rebuilt from the kept particles):\n"
+       << "  --status S         keep particles with this status\n"
+       << "  --final-state      same as --status 1\n"
+       << "  --pdg ID           keep particles with |pdg_id| ID\n"
+       << "  --pt-min X         keep particles with pT >= X\n"
+       << "  --eta-max X        keep particles with |eta| <= X\n"
+       << "  --e-min X          keep particles with E >= X\n"
+       << "  Options given more than once are or-ed, --require-pdg is and-ed.\n"
+       << "  --require-pdg and --min-particles apply after particle selection.\n"
+       << "  Momenta are in the units of each event.\n"
+       << "\n"
+       << "running:\n"
+       << "  -j N               parse on N threads (default 1)\n"
+       << "  -w N               hold at most N events in memory (default 8 per thread)\n"
+       << "  --progress N       report every N events read (default 10000, 0 = never)\n"
+       << "  -h, --help         print this message\n";
+}
+
+bool to_long( const char* s, long& v )
+{
+    char* end;
+    v = std::strtol( s, &end, 10 );
+    return *s && !*end;
+}
+
+bool to_double( const char* s, double& v )
+{
+    char* end;
+    v = std::strtod( s, &end );
+    return *s && !*end;
+}
+
+void report( std::ostream& os, long nread, long nwritten, long nerror,
+             double bytes, double start )
+{
+    double t = now() - start;
+    if ( t <= 0 ) t = 1.e-9;
+    os << "hepmc-filter: read " << nread << " events, wrote " << nwritten
+       << ", rejected " << nread - nwritten - nerror;
+    if ( nerror ) os << ", " << nerror << " unreadable";
+    os << " in " << t << " s (" << nread/t << " events/s, "
+       << bytes/t/1.e6 << " MB/s)" << std::endl;
+}
+
+} // unnamed namespace
+
+int main( int argc, char** argv )
+{
+    Selection sel;
+    long nthreads = 1, window = 0, skip = 0, count = -1, progress = 10000;
+    std::vector<const char*> files;
+    for ( int i = 1; i < argc; ++i ) {
+	std::string opt = argv[i];
+	bool has_arg = i+1 < argc;
+	long l = 0;
+	double d = 0;
+	if ( opt == "-h" || opt == "--help" ) {
+	    usage( std::cout );
+	    return 0;
+	} else if ( opt == "--final-state" ) {
+	    sel.statuses.push_back( 1 );
+	} else if ( opt.size() > 1 && opt[0] == '-' && !has_arg ) {
+	    std::cerr << "hepmc-filter: bad option or missing value " << opt << std::endl;
+	    usage( std::cerr );
+	    return 1;
+	} else if ( opt == "-j" && to_long( argv[i+1], l ) && l > 0 ) {
+	    nthreads = l; ++i;
+	} else if ( opt == "-w" && to_long( argv[i+1], l ) && l > 0 ) {
+	    window = l; ++i;
+	} else if ( opt == "--progress" && to_long( argv[i+1], l ) && l >= 0 ) {
+	    progress = l; ++i;
+	} else if ( opt == "--skip" && to_long( argv[i+1], l ) && l >= 0 ) {
+	    skip = l; ++i;
+	} else if ( opt == "--count" && to_long( argv[i+1], l ) && l >= 0 ) {
+	    count = l; ++i;
+	} else if ( opt == "--process" && to_long( argv[i+1], l ) ) {
+	    sel.process_ids.push_back( l ); ++i;
+	} else if ( opt == "--require-pdg" && to_long( argv[i+1], l ) ) {
+	    sel.required_pdg.push_back( std::abs(l) ); ++i;
+	} else if ( opt == "--min-particles" && to_long( argv[i+1], l ) ) {
+	    sel.min_particles = l; ++i;
+	} else if ( opt == "--status" && to_long( argv[i+1], l ) ) {
+	    sel.statuses.push_back( l ); ++i;
+	} else if ( opt == "--pdg" && to_long( argv[i+1], l ) ) {
+	    sel.pdg_ids.push_back( std::abs(l) ); ++i;
+	} else if ( opt == "--pt-min" && to_double( argv[i+1], d ) ) {
+	    sel.pt_min = d; ++i;
+	} else if ( opt == "--eta-max" && to_double( argv[i+1], d ) ) {
+	    sel.eta_max = d; ++i;
+	} else if ( opt == "--e-min" && to_double( argv[i+1], d ) ) {
+	    sel.e_min = d; ++i;
+	} else if ( opt == "-" || opt[0] != '-' ) {
+	    files.push_back( argv[i] );
+	} else {
+	    std::cerr << "hepmc-filter: bad option " << opt;
+	    if ( has_arg ) std::cerr << " " << argv[i+1];
+	    std::cerr << std::endl;
+	    usage( std::cerr );
+	    return 1;
+	}
+    }
+    if ( files.size() != 2 ) {
+	usage( std::cerr );
+	return 1;
+    }
+    sel.slim = !sel.statuses.empty() || !sel.pdg_ids.empty()
+               || sel.pt_min >= 0 || sel.eta_max >= 0 || sel.e_min >= 0;
+    if ( window == 0 ) window = 8*nthreads;
+    if ( window < nthreads ) window = nthreads;
+
+    std::ifstream infile;
+    std::istream* in = &std::cin;
+    if ( std::strcmp( files[0], "-" ) != 0 ) {
+	infile.open( files[0] );
+	if ( !infile ) {
+	    std::cerr << "hepmc-filter: cannot open " << files[0] << std::endl;
+	    return 1;
+	}
+	in = &infile;
+    }
+    std::ofstream outfile;
+    std::ostream* out = &std::cout;
+    if ( std::strcmp( files[1], "-" ) != 0 ) {
+	outfile.open( files[1] );
+	if ( !outfile ) {
+	    std::cerr << "hepmc-filter: cannot open " << files[1] << std::endl;
+	    return 1;
+	}
+	out = &outfile;
+    }
+    EventSplitter splitter( *in );
+    HepMC::IO_GenEvent writer( *out );
+
+    Pipeline pl( window );
+    pl.sel = &sel;
+    std::vector<pthread_t> threads( nthreads );
+    for ( long t = 0; t < nthreads; ++t ) {
+	pthread_create( &threads[t], 0, worker, &pl );
+    }
+
+    double start = now();
+    long nread = 0, nwritten = 0, nerror = 0;
+    long next_read = 0, next_write = 0;
+    bool at_end = false;
+    std::string text;
+    for ( long k = 0; k < skip && splitter.next( text ); ++k ) {}
+    for (;;) {
+	// keep the window full
+	while ( !at_end && next_read - next_write < window ) {
+	    if ( count >= 0 && nread >= count ) { at_end = true; break; }
+	    if ( !splitter.next( text ) ) { at_end = true; break; }
+	    pthread_mutex_lock( &pl.mutex );
+	    // the first event defines the input format for all workers
+	    if ( pl.start_key.empty() ) pl.start_key = splitter.start_key();
+	    Slot& s = pl.slot( next_read );
+	    s.text.swap( text );
+	    s.done = false;
+	    pl.queue.push_back( next_read );
+	    pthread_cond_signal( &pl.work_ready );
+	    pthread_mutex_unlock( &pl.mutex );
+	    ++next_read;
+	    ++nread;
+	    if ( progress > 0 && nread % progress == 0 ) {
+		report( std::cerr, nread, nwritten, nerror,
+		        splitter.bytes_read(), start );
+	    }
+	}
+	if ( next_write == next_read ) break;
+	// write the oldest event as soon as it is ready
+	Slot& s = pl.slot( next_write );
+	pthread_mutex_lock( &pl.mutex );
+	while ( !s.done ) pthread_cond_wait( &pl.slot_done, &pl.mutex );
+	pthread_mutex_unlock( &pl.mutex );
+	if ( s.result ) {
+	    writer.write_event( s.result );
+	    delete s.result;
+	    s.result = 0;
+	    ++nwritten;
+	}
+	if ( s.error ) ++nerror;
+	++next_write;
+    }
+
+    pthread_mutex_lock( &pl.mutex );
+    pl.stop = true;
+    pthread_cond_broadcast( &pl.work_ready );
+    pthread_mutex_unlock( &pl.mutex );
+    for ( long t = 0; t < nthreads; ++t ) {
+	pthread_join( threads[t], 0 );
+    }
+    report( std::cerr, nread, nwritten, nerror, splitter.bytes_read(), start );
+    if ( !splitter.ok() || nerror ) return 1;
+    return 0;
+}
@@ -10,6 +10,7 @@ class ActionInitialization : public G4VUserActionInitialization
     ActionInitialization();
     ~ActionInitialization() override;
 
+    void BuildForMaster() const override;
     void Build() const override;
 };
 
@@ -4,6 +4,9 @@
 #include "G4VUserDetectorConstruction.hh"
 #include "G4GlobalMagFieldMessenger.hh"
 
+class G4UserLimits;
+class DetectorMessenger;
+
 // Define the experiment to be simulated
 class DetectorConstruction : public G4VUserDetectorConstruction
 {
@@ -14,7 +17,31 @@ class DetectorConstruction : public G4VUserDetectorConstruction
     G4VPhysicalVolume* Construct() override;
     void ConstructSDandField() override;
 
+    // Largest |eta| of a straight line from the origin that still crosses
+    // a tracker barrel, worked out from the tracker sizes in Construct()
+    G4double GetTrackerMaxEta() const { return m_trackerMaxEta; }
+
+    // Size of the outermost tracker, beyond which nothing is scored
+    G4double GetTrackerOuterRadius() const { return m_trackerOuterRadius; }
+    G4double GetTrackerHalfLength() const { return m_trackerHalfLength; }
+
+    // Regions with their own production cuts and step limits
+    // - Tracker: the silicon layers, fine cuts
+    // - World: everything else (air), the coarse default cut (1 m from main(), changed with /run/setCut)
+    static G4String GetRegionNames() { return "Tracker World"; }
+    // Step limits of a region, used by DetectorMessenger, 0 for an unknown name
+    G4UserLimits* GetUserLimits( const G4String& regionName );
+
   private:
+    G4double m_trackerMaxEta = 0.0;
+    G4double m_trackerOuterRadius = 0.0;
+    G4double m_trackerHalfLength = 0.0;
+
+    // No limits until set with the /det/ commands
+    G4UserLimits* m_trackerLimits;
+    G4UserLimits* m_worldLimits;
+    DetectorMessenger* m_messenger;
+
     // Global magnetic field messenger
     static G4ThreadLocal G4GlobalMagFieldMessenger* m_magneticFieldMessenger;
 };
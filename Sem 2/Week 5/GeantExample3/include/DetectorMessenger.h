@@ -0,0 +1,32 @@
+#ifndef DetectorMessenger_h
+#define DetectorMessenger_h 1
+
+#include "G4UImessenger.hh"
+
+class DetectorConstruction;
+class G4UIdirectory;
+class G4UIcommand;
+
+// The /det/ commands, setting the step limits of each detector region
+// The geometry is shared by all threads, so these run on the master only
+class DetectorMessenger : public G4UImessenger
+{
+  public:
+    DetectorMessenger( DetectorConstruction* detector );
+    ~DetectorMessenger() override;
+
+    void SetNewValue( G4UIcommand* command, G4String newValue ) override;
+
+  private:
+    G4UIcommand* MakeLimitCommand( const G4String& name, const G4String& guidance,
+                                   const G4String& unitCategory, const G4String& defaultUnit );
+
+    DetectorConstruction* m_detector;
+
+    G4UIdirectory* m_directory;
+    G4UIcommand* m_maxStepCmd;
+    G4UIcommand* m_maxTrackLengthCmd;
+    G4UIcommand* m_minKineticEnergyCmd;
+};
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef EventAction_h
+#define EventAction_h 1
+
+#include "G4UserEventAction.hh"
+
+class TruthWriter;
+
+// Something that happens once per event
+class EventAction : public G4UserEventAction
+{
+  public:
+    EventAction( TruthWriter* truthWriter );
+    ~EventAction() override;
+
+    void BeginOfEventAction( const G4Event* ) override;
+    void EndOfEventAction( const G4Event* ) override;
+
+  private:
+    TruthWriter* m_truthWriter;
+};
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef EventInformation_h
+#define EventInformation_h 1
+
+#include "G4VUserEventInformation.hh"
+
+class G4Event;
+
+// Extra information attached to each G4Event by the GeneratorAction
+class EventInformation : public G4VUserEventInformation
+{
+  public:
+    EventInformation( G4int generatorEventNumber );
+    ~EventInformation() override;
+
+    void Print() const override;
+
+    // Position of the generator event in the whole HepMC input chain
+    // This is what the output calls the event number, so that the output
+    // of separate jobs or threads can be joined in event order
+    G4int GetGeneratorEventNumber() const { return m_generatorEventNumber; }
+
+    // The generator event number of an event, or its Geant4 ID if it has none
+    static G4int GetEventNumber( const G4Event* event );
+
+  private:
+    G4int m_generatorEventNumber;
+};
+
+#endif
@@ -2,11 +2,19 @@
 #define GeneratorAction_h 1
 
 #include "G4VUserPrimaryGeneratorAction.hh"
-//#include "HepMC/GenEvent.h"
-#include "HepMC/IO_GenEvent.h"
+#include "G4ThreeVector.hh"
+#include "HepMCEventSource.h"
+#include "PrimaryFilter.h"
+
+#include <chrono>
+#include <vector>
+
+class G4VSolid;
+class TruthWriter;
 
 // Simplified version of Geant4 example
 // extended/eventgenerator/HepMC/HepMCEx01/include/HepMCG4Interface.hh
+// One instance per thread, all reading from the shared HepMCEventSource
 class GeneratorAction : public G4VUserPrimaryGeneratorAction
 {
   public:
@@ -16,9 +24,36 @@ class GeneratorAction : public G4VUserPrimaryGeneratorAction
     // Read a particle from the input file
     void GeneratePrimaries( G4Event* ) override;
 
+    // Called by this thread's RunAction
+    // Caches the world extent, and reports the time spent making primaries
+    void BeginOfRun();
+    void EndOfRun();
+
+    // Where to send the generator record of each event
+    void SetTruthWriter( TruthWriter* truthWriter ) { m_truthWriter = truthWriter; }
+
   private:
-    // HepMC ascii file reader
-    HepMC::IO_GenEvent* m_asciiInput = nullptr;
+    // Flag the vertices of m_event that lie inside the world
+    void FindVerticesInWorld();
+
+    // The current generator event, reused to keep its memory
+    PrimaryEvent m_event;
+    std::vector< char > m_inWorld;
+
+    // Acceptance cut on the primaries
+    PrimaryFilter m_filter;
+    TruthWriter* m_truthWriter = nullptr;
+
+    // World extent (shrunk by the surface tolerance), cached for the run
+    G4VSolid* m_worldSolid = nullptr;
+    G4bool m_worldIsBox = false;
+    G4ThreeVector m_worldMin;
+    G4ThreeVector m_worldMax;
+
+    // Timing counter
+    std::chrono::steady_clock::time_point m_runStart;
+    G4double m_generatorTime = 0.0;
+    G4int m_nEvents = 0;
 };
 
 #endif
@@ -0,0 +1,138 @@
+#ifndef HepMCEventSource_h
+#define HepMCEventSource_h 1
+
+#include "G4LorentzVector.hh"
+#include "G4ThreeVector.hh"
+#include "G4Threading.hh"
+#include "HepMC/IO_GenEvent.h"
+
+#include <fstream>
+#include <vector>
+
+class HepMCMessenger;
+
+// A final-state particle, momentum in Geant4 units
+struct PrimaryParticleData
+{
+  G4int pdgCode;
+  G4ThreeVector momentum;
+};
+
+// A vertex with final-state children, position in Geant4 units (time in ns)
+// Its particles are particles[ firstParticle ... firstParticle + nParticles - 1 ]
+struct PrimaryVertexData
+{
+  G4LorentzVector position;
+  std::size_t firstParticle;
+  std::size_t nParticles;
+};
+
+// Any particle of the generator record, for the truth output
+// Momentum and production vertex in Geant4 units
+struct TruthParticleData
+{
+  G4int barcode;
+  G4int pdgCode;
+  G4int status;
+  G4ThreeVector momentum;
+  G4ThreeVector vertex;
+};
+
+// A generator event reduced to what Geant4 needs to make primaries,
+// plus the full particle record for the truth output
+struct PrimaryEvent
+{
+  // Position of the event in the whole input chain, the same in every shard
+  G4int eventNumber = 0;
+  std::vector< PrimaryVertexData > vertices;
+  std::vector< PrimaryParticleData > particles;
+  std::vector< TruthParticleData > truth;
+};
+
+// The HepMC input shared by every worker thread
+// Each call to Next() hands out a different event, so every generated
+// event is simulated exactly once however many threads are running
+//
+// The input is a chain of files (/hepmc/addFile), indexed once by the
+// position of each event in its file.  /hepmc/shard k n restricts the
+// job to the k-th of n consecutive slices of the chain, and /hepmc/skip N
+// drops the first N events of the slice; both seek straight to the first
+// event wanted, so the other events are never parsed
+//
+// With /hepmc/preload the slice is converted once into PrimaryEvents
+// and every later run replays that table without parsing anything
+// With /hepmc/loop the input starts again from the first event of the
+// slice when a run asks for more events than the slice holds
+class HepMCEventSource
+{
+  public:
+    // The shared source, created on first use
+    // Create it on the master thread so that its commands are known there
+    static HepMCEventSource* Instance();
+    ~HepMCEventSource();
+
+    // Fill event with the next generator event
+    // Returns false when the input is exhausted
+    G4bool Next( PrimaryEvent& event );
+
+    // Called by the master at the start of each run
+    void BeginOfRun();
+
+    // Settings, used by HepMCMessenger
+    void AddFile( const G4String& fileName );
+    void SetShard( G4int shard, G4int nShards );
+    void SetSkip( G4int nSkip );
+    void SetPreload( G4bool preload );
+    void SetLoop( G4bool loop );
+
+    // Tag for output file names, empty unless the input is sharded
+    G4String GetShardTag() const;
+
+  private:
+    HepMCEventSource();
+
+    // Reduce a HepMC event to the vertices and particles Geant4 will use
+    static void Convert( const HepMC::GenEvent& hepmcEvent, PrimaryEvent& event );
+
+    // Index the input chain and work out this job's slice
+    void BuildIndex();
+    // Read the event at m_position of the chain, nullptr on failure
+    HepMC::GenEvent* ReadEvent();
+    void CloseFile();
+    void Preload();
+    void Reset();
+
+    // Everything below is only used while holding the mutex
+    G4Mutex m_mutex;
+
+    // Input chain and the start of each event in each file
+    std::vector< G4String > m_fileNames;
+    G4bool m_defaultFile = true;
+    std::vector< std::vector< std::streampos > > m_offsets;
+    G4bool m_indexed = false;
+
+    // Slice of the chain for this job: [ m_first, m_end ) after the skip
+    G4int m_shard = 0;
+    G4int m_nShards = 1;
+    std::size_t m_skip = 0;
+    std::size_t m_first = 0;
+    std::size_t m_end = 0;
+
+    // Next event of the chain to hand out, and the event of the chain
+    // the open file will read next
+    std::size_t m_position = 0;
+    std::size_t m_streamPosition = 0;
+    std::ifstream* m_stream = nullptr;
+    // HepMC ascii file reader
+    HepMC::IO_GenEvent* m_asciiInput = nullptr;
+
+    // Preloaded events, and the next one to hand out
+    std::vector< PrimaryEvent > m_table;
+    std::size_t m_nextEvent = 0;
+
+    G4bool m_preload = false;
+    G4bool m_loop = false;
+    HepMCMessenger* m_messenger = nullptr;
+};
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef HepMCMessenger_h
+#define HepMCMessenger_h 1
+
+#include "G4UImessenger.hh"
+
+class HepMCEventSource;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithABool;
+
+// The /hepmc/ commands controlling the shared HepMC input
+// They act on the master, whose settings the workers share, so none of
+// them is passed on to the worker threads
+class HepMCMessenger : public G4UImessenger
+{
+  public:
+    HepMCMessenger( HepMCEventSource* source );
+    ~HepMCMessenger() override;
+
+    void SetNewValue( G4UIcommand* command, G4String newValue ) override;
+
+  private:
+    HepMCEventSource* m_source;
+
+    G4UIdirectory* m_directory;
+    G4UIcmdWithAString* m_addFileCmd;
+    G4UIcommand* m_shardCmd;
+    G4UIcmdWithAnInteger* m_skipCmd;
+    G4UIcmdWithABool* m_preloadCmd;
+    G4UIcmdWithABool* m_loopCmd;
+};
+
+#endif
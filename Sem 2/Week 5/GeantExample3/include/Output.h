@@ -0,0 +1,34 @@
+#ifndef Output_h
+#define Output_h 1
+
+#include "G4VAnalysisManager.hh"
+
+#include <vector>
+
+// Choice of the file format for the ntuples, made on the command line
+// before any run action exists, since the ntuples are booked in its constructor
+// - csv: one text file per ntuple (the default)
+// - root: one ROOT file, compressed, worker ntuples merged by Geant4
+// - xml: one XML file per ntuple and thread
+// - hdf5: one HDF5 file per thread, compressed, if Geant4 was built with HDF5
+namespace Output
+{
+  enum Format { CSV, ROOT, XML, HDF5 };
+
+  // False for an unknown format name
+  G4bool SetFormat( const G4String& name );
+  Format GetFormat();
+
+  // Compression level of formats that support it (ROOT, HDF5), 0 for none
+  void SetCompressionLevel( G4int level );
+  G4int GetCompressionLevel();
+
+  // The analysis manager of this thread, for the chosen format
+  G4VAnalysisManager* GetAnalysisManager();
+
+  // Total size in bytes of the files of a run with this output name,
+  // in the chosen format, looking for per-thread files too
+  G4long GetOutputSize( const G4String& outputName, const std::vector< G4String >& ntupleNames, G4int nThreads );
+}
+
+#endif
@@ -2,8 +2,12 @@
 #define PositionFinder_h 1
 
 #include "G4VSensitiveDetector.hh"
+#include "TrackerHit.h"
 
+#include <unordered_map>
 
+// One tracker layer: the steps of each charged track are merged into one
+// TrackerHit, and the hits are written to the layer's ntuple once per event
 class PositionFinder : public G4VSensitiveDetector
 {
   public:
@@ -16,6 +20,10 @@ class PositionFinder : public G4VSensitiveDetector
 
   private:
     G4int m_ID;
+    G4int m_collectionID = -1;
+    TrackerHitsCollection* m_hits = nullptr;
+    // Where each track's hit is in the collection, for this event
+    std::unordered_map< G4int, std::size_t > m_hitIndex;
 };
 
 #endif
@@ -0,0 +1,62 @@
+#ifndef PrimaryFilter_h
+#define PrimaryFilter_h 1
+
+#include "globals.hh"
+#include "HepMCEventSource.h"
+
+#include <set>
+
+class PrimaryFilterMessenger;
+
+// Generator-level acceptance cut, applied before primaries reach the stack
+// Drops particles of excluded types (neutrinos by default), particles
+// outside the tracker |eta| acceptance, and particles below a momentum
+// Each thread's GeneratorAction owns one, set up by the /generator/filter/ commands
+// Off until /generator/filter/enable, as it changes the Tracker and Truth output
+class PrimaryFilter
+{
+  public:
+    PrimaryFilter();
+    ~PrimaryFilter();
+
+    // True if the particle should be tracked, and count the outcome
+    G4bool Accept( const PrimaryParticleData& particle );
+
+    // |eta| acceptance of the detector, used unless SetMaxEta gives a limit
+    void SetGeometryMaxEta( G4double eta );
+
+    // Settings, used by PrimaryFilterMessenger
+    void SetEnabled( G4bool enabled ) { m_enabled = enabled; }
+    void ExcludePdg( G4int pdgCode ) { m_excluded.insert( pdgCode ); }
+    void ClearExcluded() { m_excluded.clear(); }
+    void SetMaxEta( G4double eta );
+    void SetEtaMargin( G4double margin );
+    void SetMinMomentum( G4double momentum ) { m_minMomentum = momentum; }
+
+    // Counts for the run
+    void ResetCounts();
+    // Print the counts, and the tracking time the dropped particles would
+    // have cost at the run's average time per tracked primary
+    void PrintSummary( G4double runTime ) const;
+
+  private:
+    void UpdateEtaLimit();
+
+    G4bool m_enabled = false;
+    std::set< G4int > m_excluded;
+    G4double m_userMaxEta = 0.0;
+    G4double m_geometryMaxEta = 0.0;
+    G4double m_etaMargin = 0.1;
+    G4double m_minMomentum = 0.0;
+    // sinh of the |eta| limit, 0 for no limit
+    G4double m_maxSinhEta = 0.0;
+
+    G4int m_nSeen = 0;
+    G4int m_nExcludedPdg = 0;
+    G4int m_nOutsideEta = 0;
+    G4int m_nBelowMomentum = 0;
+
+    PrimaryFilterMessenger* m_messenger;
+};
+
+#endif
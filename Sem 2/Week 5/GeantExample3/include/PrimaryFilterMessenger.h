@@ -0,0 +1,37 @@
+#ifndef PrimaryFilterMessenger_h
+#define PrimaryFilterMessenger_h 1
+
+#include "G4UImessenger.hh"
+
+class PrimaryFilter;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithoutParameter;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithABool;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+
+// The /generator/filter/ commands, one messenger per thread's PrimaryFilter
+class PrimaryFilterMessenger : public G4UImessenger
+{
+  public:
+    PrimaryFilterMessenger( PrimaryFilter* filter );
+    ~PrimaryFilterMessenger() override;
+
+    void SetNewValue( G4UIcommand* command, G4String newValue ) override;
+
+  private:
+    PrimaryFilter* m_filter;
+
+    G4UIdirectory* m_generatorDirectory;
+    G4UIdirectory* m_directory;
+    G4UIcmdWithABool* m_enableCmd;
+    G4UIcmdWithAnInteger* m_excludePdgCmd;
+    G4UIcmdWithoutParameter* m_clearExcludedCmd;
+    G4UIcmdWithADouble* m_maxEtaCmd;
+    G4UIcmdWithADouble* m_etaMarginCmd;
+    G4UIcmdWithADoubleAndUnit* m_minMomentumCmd;
+};
+
+#endif
@@ -2,15 +2,35 @@
 #define RunAction_h 1
 
 #include "G4UserRunAction.hh"
+#include "TruthWriter.h"
+#include "TrackKiller.h"
+
+#include <chrono>
+
+class GeneratorAction;
 
 class RunAction : public G4UserRunAction
 {
   public:
-    RunAction();
+    // The generator of this thread, none on the master
+    RunAction( GeneratorAction* generator = nullptr );
     ~RunAction() override;
 
     void BeginOfRunAction( const G4Run* ) override;
     void EndOfRunAction( const G4Run* ) override;
+
+    // Writer of this thread's Truth ntuple
+    TruthWriter* GetTruthWriter() { return &m_truthWriter; }
+
+    // Track killing shared by this thread's stacking and stepping actions
+    TrackKiller* GetTrackKiller() { return &m_trackKiller; }
+
+  private:
+    GeneratorAction* m_generator;
+    TruthWriter m_truthWriter;
+    TrackKiller m_trackKiller;
+
+    std::chrono::steady_clock::time_point m_runStart;
 };
 
 #endif
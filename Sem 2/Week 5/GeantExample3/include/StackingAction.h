@@ -0,0 +1,21 @@
+#ifndef StackingAction_h
+#define StackingAction_h 1
+
+#include "G4UserStackingAction.hh"
+
+class TrackKiller;
+
+// Drop new tracks that TrackKiller says are not worth following
+class StackingAction : public G4UserStackingAction
+{
+  public:
+    StackingAction( TrackKiller* killer );
+    ~StackingAction() override;
+
+    G4ClassificationOfNewTrack ClassifyNewTrack( const G4Track* track ) override;
+
+  private:
+    TrackKiller* m_killer;
+};
+
+#endif
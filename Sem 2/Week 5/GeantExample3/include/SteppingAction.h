@@ -0,0 +1,21 @@
+#ifndef SteppingAction_h
+#define SteppingAction_h 1
+
+#include "G4UserSteppingAction.hh"
+
+class TrackKiller;
+
+// Stop tracks once they leave the region where anything is scored
+class SteppingAction : public G4UserSteppingAction
+{
+  public:
+    SteppingAction( TrackKiller* killer );
+    ~SteppingAction() override;
+
+    void UserSteppingAction( const G4Step* step ) override;
+
+  private:
+    TrackKiller* m_killer;
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef TrackKiller_h
+#define TrackKiller_h 1
+
+#include "globals.hh"
+
+#include <map>
+
+class G4Track;
+class G4Step;
+class TrackKillerMessenger;
+
+// Decides which tracks are not worth following, for the stacking and
+// stepping actions of one thread, and counts what it kills
+// - neutrinos, as soon as they are made
+// - tracks below a kinetic energy threshold for their particle type
+// - tracks outside a fiducial cylinder around the trackers, either when
+//   they are made or when they step out of it
+// Set up with the /kill/ commands; nothing is killed until one is given,
+// as it changes the Tracker and Truth output
+class TrackKiller
+{
+  public:
+    TrackKiller();
+    ~TrackKiller();
+
+    // Used by the StackingAction: true if a new track should not be tracked
+    G4bool KillNewTrack( const G4Track* track );
+    // Used by the SteppingAction: true if the track has left the fiducial volume
+    G4bool KillAfterStep( const G4Step* step );
+
+    // Fiducial volume of the detector, used unless set by command
+    void SetGeometry( G4double trackerRadius, G4double trackerHalfLength );
+
+    // Settings, used by TrackKillerMessenger
+    void SetKillNeutrinos( G4bool kill ) { m_killNeutrinos = kill; }
+    void SetThreshold( G4int pdgCode, G4double energy ) { m_thresholds[ pdgCode ] = energy; }
+    void SetFiducialRadius( G4double radius ) { m_userRadius = radius; }
+    void SetFiducialHalfLength( G4double halfLength ) { m_userHalfLength = halfLength; }
+    void SetFiducialMargin( G4double margin ) { m_margin = margin; }
+    void SetFiducialCut( G4bool cut ) { m_fiducialCut = cut; }
+
+    // Statistics for the run
+    void ResetCounts();
+    void PrintSummary( G4int nEvents ) const;
+
+  private:
+    G4bool m_killNeutrinos = false;
+    std::map< G4int, G4double > m_thresholds;
+
+    G4bool m_fiducialCut = false;
+    G4double m_userRadius = 0.0;
+    G4double m_userHalfLength = 0.0;
+    G4double m_geometryRadius = 0.0;
+    G4double m_geometryHalfLength = 0.0;
+    G4double m_margin;
+    // Limits in use for this run, squared radius for speed
+    G4double m_radius2 = 0.0;
+    G4double m_halfLength = 0.0;
+
+    G4long m_nSteps = 0;
+    G4long m_nNeutrinos = 0;
+    G4long m_nBelowThreshold = 0;
+    G4long m_nBornOutside = 0;
+    G4long m_nLeft = 0;
+
+    TrackKillerMessenger* m_messenger;
+};
+
+#endif
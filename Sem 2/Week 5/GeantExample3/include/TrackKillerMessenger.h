@@ -0,0 +1,33 @@
+#ifndef TrackKillerMessenger_h
+#define TrackKillerMessenger_h 1
+
+#include "G4UImessenger.hh"
+
+class TrackKiller;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithABool;
+class G4UIcmdWithADoubleAndUnit;
+
+// The /kill/ commands, one messenger per thread's TrackKiller
+class TrackKillerMessenger : public G4UImessenger
+{
+  public:
+    TrackKillerMessenger( TrackKiller* killer );
+    ~TrackKillerMessenger() override;
+
+    void SetNewValue( G4UIcommand* command, G4String newValue ) override;
+
+  private:
+    TrackKiller* m_killer;
+
+    G4UIdirectory* m_directory;
+    G4UIcmdWithABool* m_neutrinosCmd;
+    G4UIcommand* m_thresholdCmd;
+    G4UIcmdWithABool* m_fiducialCutCmd;
+    G4UIcmdWithADoubleAndUnit* m_fiducialRadiusCmd;
+    G4UIcmdWithADoubleAndUnit* m_fiducialHalfLengthCmd;
+    G4UIcmdWithADoubleAndUnit* m_fiducialMarginCmd;
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef TrackerHit_h
+#define TrackerHit_h 1
+
+#include "G4VHit.hh"
+#include "G4THitsCollection.hh"
+#include "G4Allocator.hh"
+#include "G4ThreeVector.hh"
+
+// All the steps of one track in one tracker layer, merged into one hit
+// The position is the average of the step midpoints weighted by the
+// energy they deposit, or the plain average if they deposit none
+class TrackerHit : public G4VHit
+{
+  public:
+    TrackerHit( G4int trackID, G4int layer );
+    ~TrackerHit() override;
+
+    inline void* operator new( size_t );
+    inline void operator delete( void* hit );
+
+    void Print() override;
+
+    // Merge in one more step
+    void AddStep( G4double energy, const G4ThreeVector& position );
+
+    G4int GetTrackID() const { return m_trackID; }
+    G4int GetLayer() const { return m_layer; }
+    G4int GetNumberOfSteps() const { return m_nSteps; }
+    G4double GetEnergy() const { return m_energy; }
+    G4ThreeVector GetPosition() const;
+
+  private:
+    G4int m_trackID;
+    G4int m_layer;
+    G4int m_nSteps = 0;
+    G4double m_energy = 0.0;
+    G4ThreeVector m_weightedPositionSum;
+    G4ThreeVector m_positionSum;
+};
+
+typedef G4THitsCollection< TrackerHit > TrackerHitsCollection;
+
+// Hits are made and deleted for every event, so they come from a pool per thread
+extern G4ThreadLocal G4Allocator< TrackerHit >* TrackerHitAllocator;
+
+inline void* TrackerHit::operator new( size_t )
+{
+  if ( !TrackerHitAllocator ) TrackerHitAllocator = new G4Allocator< TrackerHit >;
+  return (void*) TrackerHitAllocator->MallocSingle();
+}
+
+inline void TrackerHit::operator delete( void* hit )
+{
+  TrackerHitAllocator->FreeSingle( (TrackerHit*) hit );
+}
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef TruthMessenger_h
+#define TruthMessenger_h 1
+
+#include "G4UImessenger.hh"
+
+class TruthWriter;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithoutParameter;
+class G4UIcmdWithAnInteger;
+
+// The /truth/ commands, one messenger per thread's TruthWriter
+class TruthMessenger : public G4UImessenger
+{
+  public:
+    TruthMessenger( TruthWriter* writer );
+    ~TruthMessenger() override;
+
+    void SetNewValue( G4UIcommand* command, G4String newValue ) override;
+
+  private:
+    TruthWriter* m_writer;
+
+    G4UIdirectory* m_directory;
+    G4UIcmdWithAnInteger* m_addPdgCmd;
+    G4UIcmdWithoutParameter* m_clearPdgCmd;
+    G4UIcmdWithAnInteger* m_addStatusCmd;
+    G4UIcmdWithoutParameter* m_clearStatusCmd;
+};
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef TruthWriter_h
+#define TruthWriter_h 1
+
+#include "globals.hh"
+#include "HepMCEventSource.h"
+
+#include <set>
+#include <vector>
+
+class TruthMessenger;
+
+// Writes the generator particles of each event to the "Truth" ntuple
+// Particles are chosen by PDG code and status (/truth/ commands), so the
+// same program serves the ee and mumu samples.  Each event is one row,
+// with one vector column per particle property, so the whole event is
+// written with a single AddNtupleRow at the end of the event
+class TruthWriter
+{
+  public:
+    TruthWriter();
+    ~TruthWriter();
+
+    // Create the Truth ntuple, with columns bound to this writer
+    // Call from RunAction before any other ntuple, so that it gets id 0
+    void Book();
+
+    // Keep the chosen particles of the current event
+    void Collect( const PrimaryEvent& event );
+    // Write the current event, if it has any chosen particle
+    void Write();
+
+    // Settings, used by TruthMessenger
+    // An empty set selects everything
+    void AddPdg( G4int pdgCode ) { m_pdgCodes.insert( pdgCode ); }
+    void ClearPdg() { m_pdgCodes.clear(); }
+    void AddStatus( G4int status ) { m_statuses.insert( status ); }
+    void ClearStatus() { m_statuses.clear(); }
+
+  private:
+    void Clear();
+
+    std::set< G4int > m_pdgCodes;
+    std::set< G4int > m_statuses;
+    G4int m_ntupleID = -1;
+
+    // The columns of the current event
+    G4int m_eventNumber = 0;
+    std::vector< G4int > m_barcode;
+    std::vector< G4int > m_pdgCode;
+    std::vector< G4int > m_status;
+    std::vector< G4double > m_phi;
+    std::vector< G4double > m_theta;
+    std::vector< G4double > m_momentum;
+    std::vector< G4double > m_vertexX;
+    std::vector< G4double > m_vertexY;
+    std::vector< G4double > m_vertexZ;
+
+    TruthMessenger* m_messenger;
+};
+
+#endif
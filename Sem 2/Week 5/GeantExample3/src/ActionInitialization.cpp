@@ -1,6 +1,9 @@
 #include "ActionInitialization.h"
 #include "GeneratorAction.h"
 #include "RunAction.h"
+#include "EventAction.h"
+#include "StackingAction.h"
+#include "SteppingAction.h"
 
 ActionInitialization::ActionInitialization() : G4VUserActionInitialization()
 {
@@ -10,11 +13,25 @@ ActionInitialization::~ActionInitialization()
 {
 }
 
-// Two actions to set up
+// The master thread only controls the run, and joins the worker output at the end
+void ActionInitialization::BuildForMaster() const
+{
+  this->SetUserAction( new RunAction() );
+}
+
+// Actions to set up for each worker thread
 // - generating particles
 // - controlling the whole run
+// - controlling a single event
+// - dropping tracks that cannot reach the trackers
 void ActionInitialization::Build() const
 {
-  this->SetUserAction( new GeneratorAction() );
-  this->SetUserAction( new RunAction() );
+  auto generator = new GeneratorAction();
+  auto runAction = new RunAction( generator );
+  generator->SetTruthWriter( runAction->GetTruthWriter() );
+  this->SetUserAction( generator );
+  this->SetUserAction( runAction );
+  this->SetUserAction( new EventAction( runAction->GetTruthWriter() ) );
+  this->SetUserAction( new StackingAction( runAction->GetTrackKiller() ) );
+  this->SetUserAction( new SteppingAction( runAction->GetTrackKiller() ) );
 }
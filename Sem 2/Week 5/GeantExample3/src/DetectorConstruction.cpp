@@ -1,4 +1,5 @@
 #include "DetectorConstruction.h"
+#include "DetectorMessenger.h"
 #include "PositionFinder.h"
 
 #include "G4Material.hh"
@@ -11,16 +12,36 @@
 #include "G4GeometryManager.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4SDManager.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4ProductionCuts.hh"
+#include "G4UserLimits.hh"
+
+#include <algorithm>
+#include <cmath>
 
 G4ThreadLocal
 G4GlobalMagFieldMessenger* DetectorConstruction::m_magneticFieldMessenger = 0;
 
 DetectorConstruction::DetectorConstruction() : G4VUserDetectorConstruction()
 {
+  m_trackerLimits = new G4UserLimits();
+  m_worldLimits = new G4UserLimits();
+  m_messenger = new DetectorMessenger( this );
 }
 
 DetectorConstruction::~DetectorConstruction()
 {
+  delete m_messenger;
+  delete m_trackerLimits;
+  delete m_worldLimits;
+}
+
+G4UserLimits* DetectorConstruction::GetUserLimits( const G4String& regionName )
+{
+  if ( regionName == "Tracker" ) return m_trackerLimits;
+  if ( regionName == "World" ) return m_worldLimits;
+  return 0;
 }
 
 // Here we define the actual experiment that we want to perform
@@ -41,6 +62,13 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   G4double tracker2OuterRadius = 800.0*cm;
   G4double worldLength = 1000.0*cm;
 
+  // A line at polar angle theta reaches radius r at z = r*cot(theta) = r*sinh(eta),
+  // so it crosses a barrel of half length L if |sinh(eta)| < L/r
+  m_trackerMaxEta = std::max( std::asinh( tracker1Length / tracker1InnerRadius ),
+                              std::asinh( tracker2Length / tracker2InnerRadius ) );
+  m_trackerOuterRadius = std::max( tracker1OuterRadius, tracker2OuterRadius );
+  m_trackerHalfLength = std::max( tracker1Length, tracker2Length );
+
   // Definitions of Solids, Logical Volumes, Physical Volumes
 
   // WORLD: Solid (cube)
@@ -129,6 +157,25 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   // TRACKER2: Quit if there's an overlap
   if ( tracker2PV->CheckOverlaps() ) std::cerr << "WARNING: your simulated objects overlap" << std::endl;
 
+  // REGIONS: only the silicon makes hits, so secondaries are produced down to
+  // a fine cut there, while the world air keeps the coarse default cut
+  // (change them with /run/setCutForRegion Tracker ... and /run/setCut)
+  G4Region* trackerRegion = G4RegionStore::GetInstance()->GetRegion( "Tracker", false );
+  if ( !trackerRegion ) trackerRegion = new G4Region( "Tracker" );
+  trackerRegion->AddRootLogicalVolume( tracker1LV );
+  trackerRegion->AddRootLogicalVolume( tracker2LV );
+  if ( !trackerRegion->GetProductionCuts() )
+  {
+    G4ProductionCuts* trackerCuts = new G4ProductionCuts();
+    trackerCuts->SetProductionCut( 0.1*mm );
+    trackerRegion->SetProductionCuts( trackerCuts );
+  }
+
+  // Step limits, set with the /det/ commands (G4StepLimiterPhysics applies them)
+  tracker1LV->SetUserLimits( m_trackerLimits );
+  tracker2LV->SetUserLimits( m_trackerLimits );
+  worldLV->SetUserLimits( m_worldLimits );
+
   // Always return the physical world
   return worldPV;
 }
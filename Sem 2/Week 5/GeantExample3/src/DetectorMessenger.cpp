@@ -0,0 +1,66 @@
+#include "DetectorMessenger.h"
+#include "DetectorConstruction.h"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UserLimits.hh"
+
+#include <sstream>
+
+DetectorMessenger::DetectorMessenger( DetectorConstruction* detector ) : G4UImessenger(), m_detector( detector )
+{
+  m_directory = new G4UIdirectory( "/det/" );
+  m_directory->SetGuidance( "Detector regions and their step limits" );
+  m_directory->SetGuidance( "Production cuts per region are set with /run/setCutForRegion" );
+
+  m_maxStepCmd = this->MakeLimitCommand( "maxStep", "Longest step allowed in the region", "Length", "mm" );
+  m_maxTrackLengthCmd = this->MakeLimitCommand( "maxTrackLength", "Stop tracks that have travelled further than this in the region", "Length", "m" );
+  m_minKineticEnergyCmd = this->MakeLimitCommand( "minKineticEnergy", "Stop tracks below this kinetic energy in the region", "Energy", "MeV" );
+}
+
+DetectorMessenger::~DetectorMessenger()
+{
+  delete m_maxStepCmd;
+  delete m_maxTrackLengthCmd;
+  delete m_minKineticEnergyCmd;
+  delete m_directory;
+}
+
+// Each limit takes a region name, a value and a unit, e.g. /det/maxStep Tracker 1 mm
+G4UIcommand* DetectorMessenger::MakeLimitCommand( const G4String& name, const G4String& guidance,
+                                                  const G4String& unitCategory, const G4String& defaultUnit )
+{
+  G4UIcommand* command = new G4UIcommand( "/det/" + name, this );
+  command->SetGuidance( guidance );
+  command->SetGuidance( "A value of 0 removes the limit" );
+  G4UIparameter* regionParameter = new G4UIparameter( "region", 's', false );
+  regionParameter->SetParameterCandidates( DetectorConstruction::GetRegionNames() );
+  command->SetParameter( regionParameter );
+  G4UIparameter* valueParameter = new G4UIparameter( "value", 'd', false );
+  valueParameter->SetParameterRange( "value >= 0" );
+  command->SetParameter( valueParameter );
+  G4UIparameter* unitParameter = new G4UIparameter( "unit", 's', true );
+  unitParameter->SetDefaultValue( defaultUnit );
+  unitParameter->SetParameterCandidates( G4UIcommand::UnitsList( unitCategory ) );
+  command->SetParameter( unitParameter );
+  command->AvailableForStates( G4State_PreInit, G4State_Idle );
+  command->SetToBeBroadcasted( false );
+  return command;
+}
+
+void DetectorMessenger::SetNewValue( G4UIcommand* command, G4String newValue )
+{
+  G4String regionName, unit;
+  G4double value = 0.0;
+  std::istringstream( newValue ) >> regionName >> value >> unit;
+  value *= G4UIcommand::ValueOf( unit );
+
+  G4UserLimits* limits = m_detector->GetUserLimits( regionName );
+  if ( !limits ) return;
+
+  // Zero means no limit, which G4UserLimits spells DBL_MAX (or 0 for the energy)
+  if ( command == m_maxStepCmd ) limits->SetMaxAllowedStep( value > 0.0 ? value : DBL_MAX );
+  else if ( command == m_maxTrackLengthCmd ) limits->SetUserMaxTrackLength( value > 0.0 ? value : DBL_MAX );
+  else if ( command == m_minKineticEnergyCmd ) limits->SetUserMinEkine( value );
+}
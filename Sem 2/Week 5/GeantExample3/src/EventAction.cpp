@@ -0,0 +1,20 @@
+#include "EventAction.h"
+#include "TruthWriter.h"
+
+EventAction::EventAction( TruthWriter* truthWriter ) : G4UserEventAction(), m_truthWriter( truthWriter )
+{
+}
+
+EventAction::~EventAction()
+{
+}
+
+void EventAction::BeginOfEventAction( const G4Event* )
+{
+}
+
+void EventAction::EndOfEventAction( const G4Event* )
+{
+  // Write the truth record of the event in one go
+  m_truthWriter->Write();
+}
@@ -0,0 +1,24 @@
+#include "EventInformation.h"
+
+#include "G4Event.hh"
+
+EventInformation::EventInformation( G4int generatorEventNumber )
+  : G4VUserEventInformation(), m_generatorEventNumber( generatorEventNumber )
+{
+}
+
+EventInformation::~EventInformation()
+{
+}
+
+void EventInformation::Print() const
+{
+  G4cout << "Generator event number: " << m_generatorEventNumber << G4endl;
+}
+
+G4int EventInformation::GetEventNumber( const G4Event* event )
+{
+  auto information = dynamic_cast< const EventInformation* >( event->GetUserInformation() );
+  if ( information ) return information->GetGeneratorEventNumber();
+  return event->GetEventID();
+}
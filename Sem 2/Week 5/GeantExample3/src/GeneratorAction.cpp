@@ -1,7 +1,14 @@
 #include "GeneratorAction.h"
+#include "HepMCEventSource.h"
+#include "EventInformation.h"
+#include "DetectorConstruction.h"
+#include "TruthWriter.h"
 
 #include "G4RunManager.hh"
-#include "g4csv.hh"
+#include "G4Box.hh"
+#include "G4GeometryTolerance.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Navigator.hh"
 #include "G4LorentzVector.hh"
 #include "G4PrimaryParticle.hh"
 #include "G4PrimaryVertex.hh"
@@ -12,94 +19,124 @@
 
 // Simplified version of Geant4 example
 // extended/eventgenerator/HepMC/HepMCEx01/src/HepMCG4Interface.cc
-// My only addition is the truth information output at the end
+// The HepMC reading and unit conversion is done by HepMCEventSource,
+// and the truth information output by TruthWriter
 GeneratorAction::GeneratorAction()
 {
-  // Load my input file
-  m_asciiInput = new HepMC::IO_GenEvent( "data/1000.mumu.dat", std::ios::in );
-  //m_asciiInput = new HepMC::IO_GenEvent( "data/1000.ee.dat", std::ios::in );
 }
 
 GeneratorAction::~GeneratorAction()
 {
-  delete m_asciiInput;
+}
+
+// Look up the world once per run rather than for every vertex
+void GeneratorAction::BeginOfRun()
+{
+  G4Navigator* navigator = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+  m_worldSolid = navigator->GetWorldVolume()->GetLogicalVolume()->GetSolid();
+  m_worldIsBox = ( dynamic_cast< G4Box* >( m_worldSolid ) != nullptr );
+
+  // Inside() only says kInside more than half a tolerance from the surface
+  m_worldSolid->BoundingLimits( m_worldMin, m_worldMax );
+  G4double tolerance = 0.5 * G4GeometryTolerance::GetInstance()->GetSurfaceTolerance();
+  m_worldMin += G4ThreeVector( tolerance, tolerance, tolerance );
+  m_worldMax -= G4ThreeVector( tolerance, tolerance, tolerance );
+
+  // The primary filter's |eta| limit follows the tracker geometry
+  auto detector = static_cast< const DetectorConstruction* >( G4RunManager::GetRunManager()->GetUserDetectorConstruction() );
+  m_filter.SetGeometryMaxEta( detector->GetTrackerMaxEta() );
+  m_filter.ResetCounts();
+
+  m_generatorTime = 0.0;
+  m_nEvents = 0;
+  m_runStart = std::chrono::steady_clock::now();
+}
+
+void GeneratorAction::EndOfRun()
+{
+  if ( m_nEvents == 0 ) return;
+  G4double runTime = std::chrono::duration< G4double >( std::chrono::steady_clock::now() - m_runStart ).count();
+  G4cout << "GeneratorAction: " << m_nEvents << " events, "
+         << 1.0e6 * m_generatorTime / m_nEvents << " us per event making primaries, "
+         << 100.0 * m_generatorTime / runTime << "% of the run time" << G4endl;
+  m_filter.PrintSummary( runTime );
+}
+
+// Test all vertex positions against the cached world extent in one loop
+void GeneratorAction::FindVerticesInWorld()
+{
+  const std::size_t nVertices = m_event.vertices.size();
+  m_inWorld.resize( nVertices );
+  const PrimaryVertexData* vertices = m_event.vertices.data();
+  char* inWorld = m_inWorld.data();
+  const G4double xMin = m_worldMin.x(), yMin = m_worldMin.y(), zMin = m_worldMin.z();
+  const G4double xMax = m_worldMax.x(), yMax = m_worldMax.y(), zMax = m_worldMax.z();
+  for ( std::size_t i = 0; i < nVertices; ++i )
+  {
+    const G4LorentzVector& x = vertices[i].position;
+    inWorld[i] = ( x.x() > xMin ) & ( x.x() < xMax )
+               & ( x.y() > yMin ) & ( x.y() < yMax )
+               & ( x.z() > zMin ) & ( x.z() < zMax );
+  }
+
+  // The bounding box is exact for a box world, otherwise ask the solid
+  if ( !m_worldIsBox )
+  {
+    for ( std::size_t i = 0; i < nVertices; ++i )
+    {
+      if ( inWorld[i] ) inWorld[i] = ( m_worldSolid->Inside( vertices[i].position.vect() ) == kInside );
+    }
+  }
 }
 
 void GeneratorAction::GeneratePrimaries( G4Event* anEvent )
 {
-  // Load next event from file
-  HepMC::GenEvent* hepmcEvent = m_asciiInput->read_next_event();
-  if ( !hepmcEvent )
+  auto start = std::chrono::steady_clock::now();
+
+  // Load next event from the input shared by all threads
+  if ( !HepMCEventSource::Instance()->Next( m_event ) )
   {
     G4cout << "HepMCInterface: no generated particles. Run terminated..." << G4endl;
     G4RunManager::GetRunManager()->AbortRun();
     return;
   }
 
-  // Loop over all event vertices
-  for( auto vitr = hepmcEvent->vertices_begin(); vitr != hepmcEvent->vertices_end(); ++vitr )
-  {
-    // Check that the vertex has valid particles
-    G4bool valid = false;
-    for ( auto pitr= (*vitr)->particles_begin( HepMC::children ); pitr != (*vitr)->particles_end( HepMC::children ); ++pitr)
-    {
-      if ( !(*pitr)->end_vertex() && (*pitr)->status() == 1 )
-      {
-        valid = true;
-        break;
-      }
-    }
-    if ( !valid ) continue; // skip to next vertex in loop
+  // Label the event with its place in the input, for the output files
+  anEvent->SetUserInformation( new EventInformation( m_event.eventNumber ) );
+
+  // Check which vertices are inside the world
+  if ( !m_worldSolid ) this->BeginOfRun();
+  this->FindVerticesInWorld();
 
-    // Find vertex position 
-    HepMC::FourVector pos = (*vitr)->position();
-    G4LorentzVector xvtx( pos.x(), pos.y(), pos.z(), pos.t() );
+  // Keep the generator truth, written out at the end of the event
+  if ( m_truthWriter ) m_truthWriter->Collect( m_event );
 
-    // Check the vertex is inside the world
-    G4Navigator* navigator = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
-    G4VPhysicalVolume* world = navigator->GetWorldVolume();
-    G4VSolid* solid = world->GetLogicalVolume()->GetSolid();
-    EInside qinside = solid->Inside( xvtx.vect()*mm );
-    if ( qinside != kInside ) continue; // skip to next vertex in loop
+  // One pass over the vertices, each followed by its particles
+  for ( std::size_t v = 0; v < m_event.vertices.size(); ++v )
+  {
+    if ( !m_inWorld[v] ) continue; // skip to next vertex in loop
+    const PrimaryVertexData& vertex = m_event.vertices[v];
 
-    // Make the vertex (input lengths in mm)
-    G4PrimaryVertex* g4vtx = new G4PrimaryVertex( xvtx.x()*mm,
-                                                  xvtx.y()*mm,
-                                                  xvtx.z()*mm,
-                                                  xvtx.t()*mm / c_light );
+    // Make the vertex (already in Geant4 units)
+    G4PrimaryVertex* g4vtx = new G4PrimaryVertex( vertex.position.vect(), vertex.position.t() );
 
     // Loop over all particles for this vertex
-    for ( auto vpitr = (*vitr)->particles_begin( HepMC::children ); vpitr != (*vitr)->particles_end( HepMC::children ); ++vpitr )
+    const PrimaryParticleData* particle = m_event.particles.data() + vertex.firstParticle;
+    for ( std::size_t i = 0; i < vertex.nParticles; ++i, ++particle )
     {
-      if ( (*vpitr)->status() != 1 ) continue; // skip to next particle in loop
-
-      // Make the particle (input energies in MeV)
-      G4int pdgcode = (*vpitr)->pdg_id();
-      HepMC::FourVector mom = (*vpitr)->momentum();
-      G4PrimaryParticle* g4prim = new G4PrimaryParticle( pdgcode, mom.px()*MeV, mom.py()*MeV, mom.pz()*MeV );
-
-      // Output truth information for muons ( pdg 13 ) or electrons ( pdg 11 )
-      if ( pdgcode == 13 || pdgcode == -13 )
-      //if ( pdgcode == 11 || pdgcode == -11 )
-      {
-        // Get analysis manager
-        auto analysisManager = G4AnalysisManager::Instance();
-
-        // Fill ntuple
-        analysisManager->FillNtupleIColumn( 0, 0, anEvent->GetEventID() );
-        analysisManager->FillNtupleDColumn( 0, 1, g4prim->GetMomentum().phi() );
-        analysisManager->FillNtupleDColumn( 0, 2, g4prim->GetMomentum().theta() );
-        // Divide by the unit when outputting
-        // see http://geant4.web.cern.ch/sites/geant4.web.cern.ch/files/geant4/collaboration/working_groups/electromagnetic/gallery/units/SystemOfUnits.html
-        analysisManager->FillNtupleDColumn( 0, 3, g4prim->GetMomentum().mag()/GeV );
-        analysisManager->AddNtupleRow( 0 );
-      }
-
-      // Add my particle to the vertex
+      // Don't track particles that can't reach the trackers
+      if ( !m_filter.Accept( *particle ) ) continue; // skip to next particle in loop
+
+      // Make the particle and add it to the vertex
+      G4PrimaryParticle* g4prim = new G4PrimaryParticle( particle->pdgCode, particle->momentum.x(), particle->momentum.y(), particle->momentum.z() );
       g4vtx->SetPrimary( g4prim );
     }
 
-    // Add my vertex to the event
-    anEvent->AddPrimaryVertex( g4vtx );
+    // Add my vertex to the event, unless the filter emptied it
+    if ( g4vtx->GetNumberOfParticle() > 0 ) anEvent->AddPrimaryVertex( g4vtx );
+    else delete g4vtx;
   }
+
+  m_generatorTime += std::chrono::duration< G4double >( std::chrono::steady_clock::now() - start ).count();
+  ++m_nEvents;
 }
@@ -0,0 +1,287 @@
+#include "HepMCEventSource.h"
+#include "HepMCMessenger.h"
+
+#include "G4AutoLock.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "HepMC/Units.h"
+
+#include <algorithm>
+#include <string>
+
+HepMCEventSource* HepMCEventSource::Instance()
+{
+  // Constructed once, by whichever thread gets here first
+  static HepMCEventSource instance;
+  return &instance;
+}
+
+HepMCEventSource::HepMCEventSource()
+{
+  // My input file, unless /hepmc/addFile is used
+  m_fileNames.push_back( "data/1000.mumu.dat" );
+  //m_fileNames.push_back( "data/1000.ee.dat" );
+
+  m_messenger = new HepMCMessenger( this );
+}
+
+HepMCEventSource::~HepMCEventSource()
+{
+  delete m_messenger;
+  this->CloseFile();
+}
+
+void HepMCEventSource::AddFile( const G4String& fileName )
+{
+  G4AutoLock lock( &m_mutex );
+  if ( m_defaultFile ) m_fileNames.clear();
+  m_defaultFile = false;
+  m_fileNames.push_back( fileName );
+  this->Reset();
+}
+
+void HepMCEventSource::SetShard( G4int shard, G4int nShards )
+{
+  if ( nShards < 1 || shard < 0 || shard >= nShards )
+  {
+    G4cerr << "HepMCEventSource: no shard " << shard << " of " << nShards << G4endl;
+    return;
+  }
+  G4AutoLock lock( &m_mutex );
+  m_shard = shard;
+  m_nShards = nShards;
+  this->Reset();
+}
+
+void HepMCEventSource::SetSkip( G4int nSkip )
+{
+  G4AutoLock lock( &m_mutex );
+  m_skip = std::max( nSkip, 0 );
+  this->Reset();
+}
+
+void HepMCEventSource::SetPreload( G4bool preload )
+{
+  G4AutoLock lock( &m_mutex );
+  m_preload = preload;
+}
+
+void HepMCEventSource::SetLoop( G4bool loop )
+{
+  G4AutoLock lock( &m_mutex );
+  m_loop = loop;
+}
+
+G4String HepMCEventSource::GetShardTag() const
+{
+  if ( m_nShards == 1 ) return "";
+  return "_shard" + std::to_string( m_shard ) + "of" + std::to_string( m_nShards );
+}
+
+// Forget everything that depends on the input settings
+void HepMCEventSource::Reset()
+{
+  m_indexed = false;
+  m_table.clear();
+  m_nextEvent = 0;
+  this->CloseFile();
+}
+
+void HepMCEventSource::CloseFile()
+{
+  delete m_asciiInput;
+  m_asciiInput = nullptr;
+  delete m_stream;
+  m_stream = nullptr;
+}
+
+// Find where each event starts, reading lines but parsing nothing
+void HepMCEventSource::BuildIndex()
+{
+  if ( m_indexed ) return;
+
+  std::size_t nEvents = 0;
+  m_offsets.assign( m_fileNames.size(), std::vector< std::streampos >() );
+  for ( std::size_t file = 0; file < m_fileNames.size(); ++file )
+  {
+    std::ifstream scan( m_fileNames[ file ] );
+    if ( !scan ) G4cerr << "HepMCEventSource: cannot open " << m_fileNames[ file ] << G4endl;
+    std::string line;
+    std::streampos start = scan.tellg();
+    while ( std::getline( scan, line ) )
+    {
+      if ( line.size() > 1 && line[0] == 'E' && line[1] == ' ' ) m_offsets[ file ].push_back( start );
+      start = scan.tellg();
+    }
+    nEvents += m_offsets[ file ].size();
+  }
+
+  // Consecutive slices, so the outputs of all slices join in event order
+  std::size_t sliceBegin = nEvents * m_shard / m_nShards;
+  m_end = nEvents * ( m_shard + 1 ) / m_nShards;
+  m_first = std::min( sliceBegin + m_skip, m_end );
+  m_position = m_first;
+  m_indexed = true;
+
+  G4cout << "HepMCEventSource: " << nEvents << " events in " << m_fileNames.size()
+         << " files, reading events " << m_first << " to " << m_end << G4endl;
+}
+
+HepMC::GenEvent* HepMCEventSource::ReadEvent()
+{
+  // Find the file holding the event
+  std::size_t file = 0;
+  std::size_t fileBegin = 0;
+  while ( file < m_offsets.size() && m_position >= fileBegin + m_offsets[ file ].size() )
+  {
+    fileBegin += m_offsets[ file ].size();
+    ++file;
+  }
+  if ( file == m_offsets.size() ) return nullptr;
+
+  // Reading on from the last event needs no seek, anything else jumps
+  // straight to the start of the event
+  if ( !m_asciiInput || m_position != m_streamPosition
+       || m_position == fileBegin )
+  {
+    this->CloseFile();
+    m_stream = new std::ifstream( m_fileNames[ file ] );
+    m_stream->seekg( m_offsets[ file ][ m_position - fileBegin ] );
+    m_asciiInput = new HepMC::IO_GenEvent( *m_stream );
+  }
+
+  HepMC::GenEvent* hepmcEvent = m_asciiInput->read_next_event();
+  ++m_position;
+  m_streamPosition = m_position;
+  return hepmcEvent;
+}
+
+// Parse the whole slice once, keeping only what Convert() keeps
+void HepMCEventSource::Preload()
+{
+  for ( m_position = m_first; m_position < m_end; )
+  {
+    std::size_t eventNumber = m_position;
+    HepMC::GenEvent* hepmcEvent = this->ReadEvent();
+    if ( !hepmcEvent ) break;
+    m_table.emplace_back();
+    Convert( *hepmcEvent, m_table.back() );
+    m_table.back().eventNumber = eventNumber;
+    delete hepmcEvent;
+  }
+  this->CloseFile();
+  m_position = m_first;
+  G4cout << "HepMCEventSource: preloaded " << m_table.size() << " events" << G4endl;
+}
+
+void HepMCEventSource::BeginOfRun()
+{
+  G4AutoLock lock( &m_mutex );
+  this->BuildIndex();
+
+  // Every run replays the table from the start
+  if ( m_preload && m_table.empty() ) this->Preload();
+  m_nextEvent = 0;
+}
+
+G4bool HepMCEventSource::Next( PrimaryEvent& event )
+{
+  G4AutoLock lock( &m_mutex );
+  this->BuildIndex();
+
+  // Replay from memory
+  if ( m_preload )
+  {
+    if ( m_table.empty() ) this->Preload();
+    if ( m_nextEvent >= m_table.size() )
+    {
+      if ( !m_loop || m_table.empty() ) return false;
+      m_nextEvent = 0;
+    }
+    event = m_table[ m_nextEvent++ ];
+    return true;
+  }
+
+  // Read from the files
+  if ( m_position >= m_end )
+  {
+    if ( !m_loop || m_first == m_end ) return false;
+    m_position = m_first;
+  }
+  std::size_t eventNumber = m_position;
+  HepMC::GenEvent* hepmcEvent = this->ReadEvent();
+  if ( !hepmcEvent ) return false;
+  lock.unlock();
+
+  Convert( *hepmcEvent, event );
+  event.eventNumber = eventNumber;
+  delete hepmcEvent;
+  return true;
+}
+
+void HepMCEventSource::Convert( const HepMC::GenEvent& hepmcEvent, PrimaryEvent& event )
+{
+  event.vertices.clear();
+  event.particles.clear();
+  event.truth.clear();
+
+  // Scale factors from the units of the file to Geant4 units
+  G4double momentumUnit = HepMC::Units::conversion_factor( hepmcEvent.momentum_unit(), HepMC::Units::MEV ) * MeV;
+  G4double lengthUnit = HepMC::Units::conversion_factor( hepmcEvent.length_unit(), HepMC::Units::MM ) * mm;
+
+  // Every particle of the record, for the truth output
+  event.truth.reserve( hepmcEvent.particles_size() );
+  for ( auto pitr = hepmcEvent.particles_begin(); pitr != hepmcEvent.particles_end(); ++pitr )
+  {
+    HepMC::FourVector mom = (*pitr)->momentum();
+    TruthParticleData particle;
+    particle.barcode = (*pitr)->barcode();
+    particle.pdgCode = (*pitr)->pdg_id();
+    particle.status = (*pitr)->status();
+    particle.momentum = G4ThreeVector( mom.px()*momentumUnit, mom.py()*momentumUnit, mom.pz()*momentumUnit );
+    if ( (*pitr)->production_vertex() )
+    {
+      HepMC::FourVector pos = (*pitr)->production_vertex()->position();
+      particle.vertex = G4ThreeVector( pos.x()*lengthUnit, pos.y()*lengthUnit, pos.z()*lengthUnit );
+    }
+    event.truth.push_back( particle );
+  }
+
+  // Loop over all event vertices
+  for( auto vitr = hepmcEvent.vertices_begin(); vitr != hepmcEvent.vertices_end(); ++vitr )
+  {
+    // Check that the vertex has valid particles
+    G4bool valid = false;
+    for ( auto pitr= (*vitr)->particles_begin( HepMC::children ); pitr != (*vitr)->particles_end( HepMC::children ); ++pitr)
+    {
+      if ( !(*pitr)->end_vertex() && (*pitr)->status() == 1 )
+      {
+        valid = true;
+        break;
+      }
+    }
+    if ( !valid ) continue; // skip to next vertex in loop
+
+    // Find vertex position (the time is stored as c*t)
+    HepMC::FourVector pos = (*vitr)->position();
+    PrimaryVertexData vertex;
+    vertex.position = G4LorentzVector( pos.x()*lengthUnit, pos.y()*lengthUnit, pos.z()*lengthUnit,
+                                       pos.t()*lengthUnit / c_light );
+    vertex.firstParticle = event.particles.size();
+
+    // Keep the final-state particles for this vertex
+    for ( auto vpitr = (*vitr)->particles_begin( HepMC::children ); vpitr != (*vitr)->particles_end( HepMC::children ); ++vpitr )
+    {
+      if ( (*vpitr)->status() != 1 ) continue; // skip to next particle in loop
+
+      HepMC::FourVector mom = (*vpitr)->momentum();
+      PrimaryParticleData particle;
+      particle.pdgCode = (*vpitr)->pdg_id();
+      particle.momentum = G4ThreeVector( mom.px()*momentumUnit, mom.py()*momentumUnit, mom.pz()*momentumUnit );
+      event.particles.push_back( particle );
+    }
+
+    vertex.nParticles = event.particles.size() - vertex.firstParticle;
+    event.vertices.push_back( vertex );
+  }
+}
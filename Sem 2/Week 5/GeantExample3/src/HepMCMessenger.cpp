@@ -0,0 +1,93 @@
+#include "HepMCMessenger.h"
+#include "HepMCEventSource.h"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithABool.hh"
+
+#include <sstream>
+
+HepMCMessenger::HepMCMessenger( HepMCEventSource* source ) : G4UImessenger(), m_source( source )
+{
+  m_directory = new G4UIdirectory( "/hepmc/", false );
+  m_directory->SetGuidance( "HepMC input control" );
+
+  m_addFileCmd = new G4UIcmdWithAString( "/hepmc/addFile", this );
+  m_addFileCmd->SetGuidance( "Append a HepMC file to the input chain" );
+  m_addFileCmd->SetGuidance( "The first file given replaces the default input" );
+  m_addFileCmd->SetParameterName( "fileName", false );
+  m_addFileCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+  m_addFileCmd->SetToBeBroadcasted( false );
+
+  m_shardCmd = new G4UIcommand( "/hepmc/shard", this );
+  m_shardCmd->SetGuidance( "Only simulate slice k of n equal slices of the input chain" );
+  m_shardCmd->SetGuidance( "Slices are consecutive, so their outputs join in event order" );
+  G4UIparameter* shardParameter = new G4UIparameter( "k", 'i', false );
+  shardParameter->SetParameterRange( "k >= 0" );
+  m_shardCmd->SetParameter( shardParameter );
+  G4UIparameter* nShardsParameter = new G4UIparameter( "n", 'i', false );
+  nShardsParameter->SetParameterRange( "n >= 1" );
+  m_shardCmd->SetParameter( nShardsParameter );
+  m_shardCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+  m_shardCmd->SetToBeBroadcasted( false );
+
+  m_skipCmd = new G4UIcmdWithAnInteger( "/hepmc/skip", this );
+  m_skipCmd->SetGuidance( "Skip the first N events of this slice" );
+  m_skipCmd->SetParameterName( "N", false );
+  m_skipCmd->SetRange( "N >= 0" );
+  m_skipCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+  m_skipCmd->SetToBeBroadcasted( false );
+
+  m_preloadCmd = new G4UIcmdWithABool( "/hepmc/preload", this );
+  m_preloadCmd->SetGuidance( "Read the whole slice once and replay it in every run" );
+  m_preloadCmd->SetParameterName( "preload", true );
+  m_preloadCmd->SetDefaultValue( true );
+  m_preloadCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+  m_preloadCmd->SetToBeBroadcasted( false );
+
+  m_loopCmd = new G4UIcmdWithABool( "/hepmc/loop", this );
+  m_loopCmd->SetGuidance( "Start again from the first event at the end of the slice" );
+  m_loopCmd->SetParameterName( "loop", true );
+  m_loopCmd->SetDefaultValue( true );
+  m_loopCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+  m_loopCmd->SetToBeBroadcasted( false );
+}
+
+HepMCMessenger::~HepMCMessenger()
+{
+  delete m_addFileCmd;
+  delete m_shardCmd;
+  delete m_skipCmd;
+  delete m_preloadCmd;
+  delete m_loopCmd;
+  delete m_directory;
+}
+
+void HepMCMessenger::SetNewValue( G4UIcommand* command, G4String newValue )
+{
+  if ( command == m_addFileCmd )
+  {
+    m_source->AddFile( newValue );
+  }
+  else if ( command == m_shardCmd )
+  {
+    G4int shard = 0, nShards = 1;
+    std::istringstream( newValue ) >> shard >> nShards;
+    m_source->SetShard( shard, nShards );
+  }
+  else if ( command == m_skipCmd )
+  {
+    m_source->SetSkip( m_skipCmd->GetNewIntValue( newValue ) );
+  }
+  else if ( command == m_preloadCmd )
+  {
+    m_source->SetPreload( m_preloadCmd->GetNewBoolValue( newValue ) );
+  }
+  else if ( command == m_loopCmd )
+  {
+    m_source->SetLoop( m_loopCmd->GetNewBoolValue( newValue ) );
+  }
+}
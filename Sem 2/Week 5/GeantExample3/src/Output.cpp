@@ -0,0 +1,86 @@
+#include "Output.h"
+
+#include "G4CsvAnalysisManager.hh"
+#include "G4RootAnalysisManager.hh"
+#include "G4XmlAnalysisManager.hh"
+#ifdef WITH_HDF5
+#include "G4Hdf5AnalysisManager.hh"
+#endif
+
+#include <fstream>
+
+namespace
+{
+  // Set once by main(), before the worker threads start
+  Output::Format format = Output::CSV;
+  G4int compressionLevel = 1;
+
+  // Size of a file in bytes, 0 if it does not exist
+  G4long FileSize( const G4String& fileName )
+  {
+    std::ifstream file( fileName, std::ios::binary | std::ios::ate );
+    if ( !file ) return 0;
+    return file.tellg();
+  }
+}
+
+G4bool Output::SetFormat( const G4String& name )
+{
+  if ( name == "csv" ) format = CSV;
+  else if ( name == "root" ) format = ROOT;
+  else if ( name == "xml" ) format = XML;
+#ifdef WITH_HDF5
+  else if ( name == "hdf5" ) format = HDF5;
+#endif
+  else return false;
+  return true;
+}
+
+Output::Format Output::GetFormat()
+{
+  return format;
+}
+
+void Output::SetCompressionLevel( G4int level )
+{
+  compressionLevel = level;
+}
+
+G4int Output::GetCompressionLevel()
+{
+  return compressionLevel;
+}
+
+G4VAnalysisManager* Output::GetAnalysisManager()
+{
+  switch ( format )
+  {
+    case ROOT: return G4RootAnalysisManager::Instance();
+    case XML: return G4XmlAnalysisManager::Instance();
+#ifdef WITH_HDF5
+    case HDF5: return G4Hdf5AnalysisManager::Instance();
+#endif
+    default: return G4CsvAnalysisManager::Instance();
+  }
+}
+
+G4long Output::GetOutputSize( const G4String& outputName, const std::vector< G4String >& ntupleNames, G4int nThreads )
+{
+  // The joined file(s), then whatever the threads left behind
+  std::vector< G4String > suffixes( 1, "" );
+  for ( G4int thread = 0; thread < nThreads; ++thread ) suffixes.push_back( "_t" + std::to_string( thread ) );
+
+  G4long size = 0;
+  for ( const auto& suffix : suffixes )
+  {
+    // ROOT and HDF5 keep all the ntuples in one file
+    if ( format == ROOT ) size += FileSize( outputName + suffix + ".root" );
+    else if ( format == HDF5 ) size += FileSize( outputName + suffix + ".hdf5" );
+    else
+    {
+      G4String extension = format == XML ? ".xml" : ".csv";
+      for ( const auto& ntupleName : ntupleNames ) size += FileSize( outputName + "_nt_" + ntupleName + suffix + extension );
+    }
+  }
+  return size;
+}
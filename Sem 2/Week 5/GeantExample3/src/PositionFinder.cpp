@@ -1,41 +1,76 @@
 #include "PositionFinder.h"
+#include "EventInformation.h"
 
-#include "g4csv.hh"
+#include "Output.h"
 #include "G4RunManager.hh"
+#include "G4SDManager.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4SystemOfUnits.hh"
 
 PositionFinder::PositionFinder( const G4String& name, const G4int id ) : G4VSensitiveDetector( name )
 {
   // Set which ntuple to use
   m_ID = id;
+
+  // Hits are kept in a collection called <name>/Hits
+  collectionName.insert( "Hits" );
 }
 
 PositionFinder::~PositionFinder()
 { 
 }
 
-void PositionFinder::Initialize( G4HCofThisEvent* )
+// Start a new collection for each event
+void PositionFinder::Initialize( G4HCofThisEvent* hitsOfEvent )
 {
+  m_hits = new TrackerHitsCollection( SensitiveDetectorName, collectionName[0] );
+  if ( m_collectionID < 0 ) m_collectionID = G4SDManager::GetSDMpointer()->GetCollectionID( m_hits );
+  hitsOfEvent->AddHitsCollection( m_collectionID, m_hits );
+  m_hitIndex.clear();
 }
 
 // Analyse anything that hit the detector
 G4bool PositionFinder::ProcessHits( G4Step* step, G4TouchableHistory* )
 {
   // Tracking detectors only sense charged particles
-  if ( step->GetTrack()->GetParticleDefinition()->GetPDGCharge() != 0.0 )
-  {
-    // Get the analysis manager
-    auto analysisManager = G4AnalysisManager::Instance();
+  if ( step->GetTrack()->GetParticleDefinition()->GetPDGCharge() == 0.0 ) return false;
 
-    // Fill ntuple with my ID number
-    analysisManager->FillNtupleIColumn( m_ID, 0, G4RunManager::GetRunManager()->GetCurrentEvent()->GetEventID() ); // Column 0 - event number
-    analysisManager->FillNtupleDColumn( m_ID, 1, step->GetTrack()->GetPosition().phi() );                          // Column 1 - phi coordinate of hit
-    analysisManager->FillNtupleDColumn( m_ID, 2, step->GetTrack()->GetPosition().theta() );                        // Column 2 - theta coordinate of hit
-    analysisManager->AddNtupleRow( m_ID ); // Row complete
+  // Find the hit of this track, or start one
+  G4int trackID = step->GetTrack()->GetTrackID();
+  auto index = m_hitIndex.find( trackID );
+  if ( index == m_hitIndex.end() )
+  {
+    index = m_hitIndex.emplace( trackID, m_hits->entries() ).first;
+    m_hits->insert( new TrackerHit( trackID, m_ID ) );
   }
 
+  // Add this step at its midpoint
+  G4ThreeVector position = 0.5 * ( step->GetPreStepPoint()->GetPosition() + step->GetPostStepPoint()->GetPosition() );
+  ( *m_hits )[ index->second ]->AddStep( step->GetTotalEnergyDeposit(), position );
+
   return true;
 }
 
+// Write one ntuple row per hit
 void PositionFinder::EndOfEvent( G4HCofThisEvent* )
 {
+  if ( m_hits->entries() == 0 ) return;
+
+  // Get the analysis manager
+  auto analysisManager = Output::GetAnalysisManager();
+  G4int eventNumber = EventInformation::GetEventNumber( G4RunManager::GetRunManager()->GetCurrentEvent() );
+
+  for ( std::size_t i = 0; i < m_hits->entries(); ++i )
+  {
+    const TrackerHit* hit = ( *m_hits )[ i ];
+    G4ThreeVector position = hit->GetPosition();
+
+    // Fill ntuple with my ID number
+    analysisManager->FillNtupleIColumn( m_ID, 0, eventNumber );          // Column 0 - event number
+    analysisManager->FillNtupleDColumn( m_ID, 1, position.phi() );       // Column 1 - phi coordinate of hit
+    analysisManager->FillNtupleDColumn( m_ID, 2, position.theta() );     // Column 2 - theta coordinate of hit
+    analysisManager->FillNtupleIColumn( m_ID, 3, hit->GetTrackID() );    // Column 3 - Geant4 track ID
+    analysisManager->FillNtupleDColumn( m_ID, 4, hit->GetEnergy() / MeV ); // Column 4 - deposited energy, MeV
+    analysisManager->AddNtupleRow( m_ID ); // Row complete
+  }
 }
@@ -0,0 +1,99 @@
+#include "PrimaryFilter.h"
+#include "PrimaryFilterMessenger.h"
+
+#include "G4SystemOfUnits.hh"
+
+#include <cmath>
+
+PrimaryFilter::PrimaryFilter()
+{
+  // Neutrinos leave without a trace
+  for ( G4int pdgCode : { 12, 14, 16 } )
+  {
+    m_excluded.insert( pdgCode );
+    m_excluded.insert( -pdgCode );
+  }
+
+  m_messenger = new PrimaryFilterMessenger( this );
+}
+
+PrimaryFilter::~PrimaryFilter()
+{
+  delete m_messenger;
+}
+
+void PrimaryFilter::SetGeometryMaxEta( G4double eta )
+{
+  m_geometryMaxEta = eta;
+  this->UpdateEtaLimit();
+}
+
+void PrimaryFilter::SetMaxEta( G4double eta )
+{
+  m_userMaxEta = eta;
+  this->UpdateEtaLimit();
+}
+
+void PrimaryFilter::SetEtaMargin( G4double margin )
+{
+  m_etaMargin = margin;
+  this->UpdateEtaLimit();
+}
+
+// Compare |pz| against sinh(eta limit) * pT, so no logarithm per particle
+void PrimaryFilter::UpdateEtaLimit()
+{
+  G4double maxEta = m_userMaxEta > 0.0 ? m_userMaxEta : m_geometryMaxEta + m_etaMargin;
+  m_maxSinhEta = ( m_userMaxEta > 0.0 || m_geometryMaxEta > 0.0 ) ? std::sinh( maxEta ) : 0.0;
+}
+
+G4bool PrimaryFilter::Accept( const PrimaryParticleData& particle )
+{
+  ++m_nSeen;
+  if ( !m_enabled ) return true;
+
+  if ( m_excluded.count( particle.pdgCode ) )
+  {
+    ++m_nExcludedPdg;
+    return false;
+  }
+
+  const G4ThreeVector& p = particle.momentum;
+  if ( m_maxSinhEta > 0.0 && std::abs( p.z() ) > m_maxSinhEta * p.perp() )
+  {
+    ++m_nOutsideEta;
+    return false;
+  }
+
+  if ( m_minMomentum > 0.0 && p.mag2() < m_minMomentum * m_minMomentum )
+  {
+    ++m_nBelowMomentum;
+    return false;
+  }
+
+  return true;
+}
+
+void PrimaryFilter::ResetCounts()
+{
+  m_nSeen = 0;
+  m_nExcludedPdg = 0;
+  m_nOutsideEta = 0;
+  m_nBelowMomentum = 0;
+}
+
+void PrimaryFilter::PrintSummary( G4double runTime ) const
+{
+  if ( !m_enabled || m_nSeen == 0 ) return;
+  G4int nDropped = m_nExcludedPdg + m_nOutsideEta + m_nBelowMomentum;
+  G4int nTracked = m_nSeen - nDropped;
+  G4cout << "PrimaryFilter: " << m_nSeen << " primaries, " << nTracked << " tracked, dropped "
+         << m_nExcludedPdg << " by type, " << m_nOutsideEta << " outside |eta| < "
+         << ( m_maxSinhEta > 0.0 ? std::asinh( m_maxSinhEta ) : 0.0 ) << ", "
+         << m_nBelowMomentum << " below " << m_minMomentum / MeV << " MeV" << G4endl;
+  if ( nTracked > 0 && nDropped > 0 )
+  {
+    G4cout << "PrimaryFilter: about " << runTime * nDropped / nTracked
+           << " s of tracking saved (at " << runTime / nTracked << " s per tracked primary)" << G4endl;
+  }
+}
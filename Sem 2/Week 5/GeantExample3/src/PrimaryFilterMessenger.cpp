@@ -0,0 +1,73 @@
+#include "PrimaryFilterMessenger.h"
+#include "PrimaryFilter.h"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+PrimaryFilterMessenger::PrimaryFilterMessenger( PrimaryFilter* filter ) : G4UImessenger(), m_filter( filter )
+{
+  m_generatorDirectory = new G4UIdirectory( "/generator/" );
+  m_generatorDirectory->SetGuidance( "Primary generator control" );
+  m_directory = new G4UIdirectory( "/generator/filter/" );
+  m_directory->SetGuidance( "Drop primaries that cannot reach the trackers before tracking them" );
+
+  m_enableCmd = new G4UIcmdWithABool( "/generator/filter/enable", this );
+  m_enableCmd->SetGuidance( "Switch the primary filter on or off (off by default)" );
+  m_enableCmd->SetParameterName( "enable", true );
+  m_enableCmd->SetDefaultValue( true );
+  m_enableCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+
+  m_excludePdgCmd = new G4UIcmdWithAnInteger( "/generator/filter/excludePdg", this );
+  m_excludePdgCmd->SetGuidance( "Never track particles with this PDG code (neutrinos are excluded by default)" );
+  m_excludePdgCmd->SetParameterName( "pdgCode", false );
+  m_excludePdgCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+
+  m_clearExcludedCmd = new G4UIcmdWithoutParameter( "/generator/filter/clearExcluded", this );
+  m_clearExcludedCmd->SetGuidance( "Empty the list of excluded PDG codes" );
+  m_clearExcludedCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+
+  m_maxEtaCmd = new G4UIcmdWithADouble( "/generator/filter/maxEta", this );
+  m_maxEtaCmd->SetGuidance( "Drop primaries with larger |eta|" );
+  m_maxEtaCmd->SetGuidance( "0 takes the limit from the tracker geometry, plus the margin" );
+  m_maxEtaCmd->SetParameterName( "maxEta", false );
+  m_maxEtaCmd->SetRange( "maxEta >= 0" );
+  m_maxEtaCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+
+  m_etaMarginCmd = new G4UIcmdWithADouble( "/generator/filter/etaMargin", this );
+  m_etaMarginCmd->SetGuidance( "Added to the |eta| acceptance of the trackers, for vertex spread and bending" );
+  m_etaMarginCmd->SetParameterName( "margin", false );
+  m_etaMarginCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+
+  m_minMomentumCmd = new G4UIcmdWithADoubleAndUnit( "/generator/filter/minMomentum", this );
+  m_minMomentumCmd->SetGuidance( "Drop primaries with a smaller momentum" );
+  m_minMomentumCmd->SetParameterName( "momentum", false );
+  m_minMomentumCmd->SetRange( "momentum >= 0" );
+  m_minMomentumCmd->SetUnitCategory( "Energy" );
+  m_minMomentumCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+}
+
+PrimaryFilterMessenger::~PrimaryFilterMessenger()
+{
+  delete m_enableCmd;
+  delete m_excludePdgCmd;
+  delete m_clearExcludedCmd;
+  delete m_maxEtaCmd;
+  delete m_etaMarginCmd;
+  delete m_minMomentumCmd;
+  delete m_directory;
+  delete m_generatorDirectory;
+}
+
+void PrimaryFilterMessenger::SetNewValue( G4UIcommand* command, G4String newValue )
+{
+  if ( command == m_enableCmd ) m_filter->SetEnabled( m_enableCmd->GetNewBoolValue( newValue ) );
+  else if ( command == m_excludePdgCmd ) m_filter->ExcludePdg( m_excludePdgCmd->GetNewIntValue( newValue ) );
+  else if ( command == m_clearExcludedCmd ) m_filter->ClearExcluded();
+  else if ( command == m_maxEtaCmd ) m_filter->SetMaxEta( m_maxEtaCmd->GetNewDoubleValue( newValue ) );
+  else if ( command == m_etaMarginCmd ) m_filter->SetEtaMargin( m_etaMarginCmd->GetNewDoubleValue( newValue ) );
+  else if ( command == m_minMomentumCmd ) m_filter->SetMinMomentum( m_minMomentumCmd->GetNewDoubleValue( newValue ) );
+}
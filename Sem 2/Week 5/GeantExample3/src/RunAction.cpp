@@ -1,56 +1,173 @@
 #include "RunAction.h"
+#include "GeneratorAction.h"
+#include "DetectorConstruction.h"
+#include "HepMCEventSource.h"
 
-#include "g4csv.hh"
+#include "Output.h"
+#include "G4RootAnalysisManager.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
 
-RunAction::RunAction() : G4UserRunAction()
+#ifdef G4MULTITHREADED
+#include "G4MTRunManager.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  // Join the files written by each worker thread (<output>_nt_<name>_t<i>.csv)
+  // into the single file a sequential run would have written, with the rows
+  // sorted by the event number in the first column
+  void MergeWorkerFiles( const std::string& outputName, const std::string& ntupleName, G4int nThreads )
+  {
+    std::string header;
+    std::vector< std::pair< G4int, std::string > > rows;
+    for ( G4int thread = 0; thread < nThreads; ++thread )
+    {
+      std::string fileName = outputName + "_nt_" + ntupleName + "_t" + std::to_string( thread ) + ".csv";
+      std::ifstream input( fileName );
+      if ( !input ) continue;
+
+      // Column descriptions start with #, and are the same in every file
+      G4bool first = header.empty();
+      std::string line;
+      while ( std::getline( input, line ) )
+      {
+        if ( !line.empty() && line[0] == '#' )
+        {
+          if ( first ) header += line + "\n";
+        }
+        else if ( !line.empty() ) rows.emplace_back( std::atoi( line.c_str() ), line );
+      }
+      input.close();
+      std::remove( fileName.c_str() );
+    }
+
+    std::stable_sort( rows.begin(), rows.end(),
+                      []( const std::pair< G4int, std::string >& a, const std::pair< G4int, std::string >& b )
+                      { return a.first < b.first; } );
+
+    std::ofstream output( outputName + "_nt_" + ntupleName + ".csv" );
+    output << header;
+    for ( const auto& row : rows ) output << row.second << "\n";
+  }
+}
+#endif
+
+RunAction::RunAction( GeneratorAction* generator ) : G4UserRunAction(), m_generator( generator )
 {
-  // Create analysis manager
-  auto analysisManager = G4AnalysisManager::Instance();
+  // Create analysis manager, for the format chosen in main()
+  auto analysisManager = Output::GetAnalysisManager();
+
+  // ROOT and HDF5 compress, and ROOT joins the worker ntuples itself into one file
+  if ( Output::GetFormat() == Output::ROOT || Output::GetFormat() == Output::HDF5 )
+  {
+    analysisManager->SetCompressionLevel( Output::GetCompressionLevel() );
+  }
+  if ( Output::GetFormat() == Output::ROOT ) G4RootAnalysisManager::Instance()->SetNtupleMerging( true );
 
   // Add an ntuple for truth (ntuple id 0)
-  analysisManager->CreateNtuple( "Truth", "Truth information" );
-  analysisManager->CreateNtupleIColumn( "EventNumber" );
-  analysisManager->CreateNtupleDColumn( "Phi" );
-  analysisManager->CreateNtupleDColumn( "Theta" );
-  analysisManager->CreateNtupleDColumn( "Momentum" );
-  analysisManager->FinishNtuple();
+  m_truthWriter.Book();
 
-  // Add an ntuple for tracker layer 1 (ntuple id 1)
+  // Add an ntuple for tracker layer 1 (ntuple id 1), one row per track crossing it
   analysisManager->CreateNtuple( "Tracker1", "Tracker 1 coordinates" );
   analysisManager->CreateNtupleIColumn( "EventNumber" );
   analysisManager->CreateNtupleDColumn( "Phi" );
   analysisManager->CreateNtupleDColumn( "Theta" );
+  analysisManager->CreateNtupleIColumn( "TrackID" );
+  analysisManager->CreateNtupleDColumn( "Energy" ); // MeV
   analysisManager->FinishNtuple();
 
-  // Add an ntuple for tracker layer 2 (ntuple id 2)
+  // Add an ntuple for tracker layer 2 (ntuple id 2), one row per track crossing it
   analysisManager->CreateNtuple( "Tracker2", "Tracker 2 coordinates" );
   analysisManager->CreateNtupleIColumn( "EventNumber" );
   analysisManager->CreateNtupleDColumn( "Phi" );
   analysisManager->CreateNtupleDColumn( "Theta" );
+  analysisManager->CreateNtupleIColumn( "TrackID" );
+  analysisManager->CreateNtupleDColumn( "Energy" ); // MeV
   analysisManager->FinishNtuple();
 }
 
 RunAction::~RunAction()
 {
   // Delete analysis manager
-  delete G4AnalysisManager::Instance();
+  delete Output::GetAnalysisManager();
 }
 
 void RunAction::BeginOfRunAction( const G4Run* )
 {
+  // The master runs this before any worker starts its events
+  if ( this->IsMaster() ) HepMCEventSource::Instance()->BeginOfRun();
+  if ( m_generator ) m_generator->BeginOfRun();
+
+  // Follow the geometry, in case it changed between runs
+  auto detector = static_cast< const DetectorConstruction* >( G4RunManager::GetRunManager()->GetUserDetectorConstruction() );
+  m_trackKiller.SetGeometry( detector->GetTrackerOuterRadius(), detector->GetTrackerHalfLength() );
+  m_trackKiller.ResetCounts();
+
   // Get analysis manager
-  auto analysisManager = G4AnalysisManager::Instance();
+  auto analysisManager = Output::GetAnalysisManager();
 
-  // Open an output file
-  analysisManager->OpenFile( "output.csv" );
+  // Open an output file, one per slice when the input is sharded
+  // (the extension follows the format)
+  analysisManager->OpenFile( "output" + HepMCEventSource::Instance()->GetShardTag() );
+
+  m_runStart = std::chrono::steady_clock::now();
 }
  
-void RunAction::EndOfRunAction( const G4Run* )
+void RunAction::EndOfRunAction( const G4Run* run )
 {
+  // Throughput of this thread, or of the whole job on the master
+  G4double runTime = std::chrono::duration< G4double >( std::chrono::steady_clock::now() - m_runStart ).count();
+  if ( run->GetNumberOfEvent() > 0 && runTime > 0.0 )
+  {
+    G4cout << "RunAction: " << run->GetNumberOfEvent() << " events in " << runTime << " s, "
+           << run->GetNumberOfEvent() / runTime << " events per second" << G4endl;
+  }
+
+  // Report the time spent making primaries, and the tracking that was saved
+  if ( m_generator )
+  {
+    m_generator->EndOfRun();
+    m_trackKiller.PrintSummary( run->GetNumberOfEvent() );
+  }
+
   // Get analysis manager
-  auto analysisManager = G4AnalysisManager::Instance();
+  auto analysisManager = Output::GetAnalysisManager();
 
   // Save output data
+  auto writeStart = std::chrono::steady_clock::now();
   analysisManager->Write();
   analysisManager->CloseFile();
+  G4double writeTime = std::chrono::duration< G4double >( std::chrono::steady_clock::now() - writeStart ).count();
+  G4cout << "RunAction: output written in " << writeTime << " s" << G4endl;
+
+  // In multithreaded mode the master runs this after all the workers have
+  // closed their files, so they can be joined here
+  G4String outputName = "output" + HepMCEventSource::Instance()->GetShardTag();
+  G4int nThreads = 0;
+#ifdef G4MULTITHREADED
+  auto mtRunManager = dynamic_cast< G4MTRunManager* >( G4RunManager::GetRunManager() );
+  if ( mtRunManager ) nThreads = mtRunManager->GetNumberOfThreads();
+  if ( this->IsMaster() && mtRunManager && Output::GetFormat() == Output::CSV )
+  {
+    for ( auto name : { "Truth", "Tracker1", "Tracker2" } )
+    {
+      MergeWorkerFiles( outputName, name, nThreads );
+    }
+  }
+#endif
+
+  // Size of everything written
+  if ( this->IsMaster() )
+  {
+    G4cout << "RunAction: " << Output::GetOutputSize( outputName, { "Truth", "Tracker1", "Tracker2" }, nThreads )
+           << " bytes of output" << G4endl;
+  }
 }
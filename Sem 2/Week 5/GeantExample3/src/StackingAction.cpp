@@ -0,0 +1,16 @@
+#include "StackingAction.h"
+#include "TrackKiller.h"
+
+StackingAction::StackingAction( TrackKiller* killer ) : G4UserStackingAction(), m_killer( killer )
+{
+}
+
+StackingAction::~StackingAction()
+{
+}
+
+G4ClassificationOfNewTrack StackingAction::ClassifyNewTrack( const G4Track* track )
+{
+  if ( m_killer->KillNewTrack( track ) ) return fKill;
+  return fUrgent;
+}
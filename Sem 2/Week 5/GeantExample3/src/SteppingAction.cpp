@@ -0,0 +1,18 @@
+#include "SteppingAction.h"
+#include "TrackKiller.h"
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+
+SteppingAction::SteppingAction( TrackKiller* killer ) : G4UserSteppingAction(), m_killer( killer )
+{
+}
+
+SteppingAction::~SteppingAction()
+{
+}
+
+void SteppingAction::UserSteppingAction( const G4Step* step )
+{
+  if ( m_killer->KillAfterStep( step ) ) step->GetTrack()->SetTrackStatus( fStopAndKill );
+}
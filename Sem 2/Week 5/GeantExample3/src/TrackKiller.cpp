@@ -0,0 +1,98 @@
+#include "TrackKiller.h"
+#include "TrackKillerMessenger.h"
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <cmath>
+
+TrackKiller::TrackKiller()
+{
+  // Room for the tracker hits of tracks that leave at an angle
+  m_margin = 10.0*cm;
+
+  m_messenger = new TrackKillerMessenger( this );
+}
+
+TrackKiller::~TrackKiller()
+{
+  delete m_messenger;
+}
+
+void TrackKiller::SetGeometry( G4double trackerRadius, G4double trackerHalfLength )
+{
+  m_geometryRadius = trackerRadius;
+  m_geometryHalfLength = trackerHalfLength;
+
+  G4double radius = m_userRadius > 0.0 ? m_userRadius : m_geometryRadius + m_margin;
+  m_radius2 = radius * radius;
+  m_halfLength = m_userHalfLength > 0.0 ? m_userHalfLength : m_geometryHalfLength + m_margin;
+}
+
+G4bool TrackKiller::KillNewTrack( const G4Track* track )
+{
+  G4int pdgCode = track->GetDefinition()->GetPDGEncoding();
+
+  // Neutrinos never leave a hit
+  G4int absPdgCode = std::abs( pdgCode );
+  if ( m_killNeutrinos && ( absPdgCode == 12 || absPdgCode == 14 || absPdgCode == 16 ) )
+  {
+    ++m_nNeutrinos;
+    return true;
+  }
+
+  // Too soft to reach anything sensitive
+  if ( !m_thresholds.empty() )
+  {
+    auto threshold = m_thresholds.find( pdgCode );
+    if ( threshold != m_thresholds.end() && track->GetKineticEnergy() < threshold->second )
+    {
+      ++m_nBelowThreshold;
+      return true;
+    }
+  }
+
+  // Made where nothing is scored
+  const G4ThreeVector& position = track->GetPosition();
+  if ( m_fiducialCut && ( position.perp2() > m_radius2 || std::abs( position.z() ) > m_halfLength ) )
+  {
+    ++m_nBornOutside;
+    return true;
+  }
+
+  return false;
+}
+
+G4bool TrackKiller::KillAfterStep( const G4Step* step )
+{
+  ++m_nSteps;
+  if ( !m_fiducialCut ) return false;
+
+  const G4ThreeVector& position = step->GetPostStepPoint()->GetPosition();
+  if ( position.perp2() > m_radius2 || std::abs( position.z() ) > m_halfLength )
+  {
+    ++m_nLeft;
+    return true;
+  }
+  return false;
+}
+
+void TrackKiller::ResetCounts()
+{
+  m_nSteps = 0;
+  m_nNeutrinos = 0;
+  m_nBelowThreshold = 0;
+  m_nBornOutside = 0;
+  m_nLeft = 0;
+}
+
+void TrackKiller::PrintSummary( G4int nEvents ) const
+{
+  if ( nEvents == 0 ) return;
+  G4cout << "TrackKiller: " << m_nSteps << " steps, " << G4double( m_nSteps ) / nEvents << " per event" << G4endl;
+  G4cout << "TrackKiller: killed " << m_nNeutrinos << " neutrinos, "
+         << m_nBelowThreshold << " tracks below threshold, "
+         << m_nBornOutside << " made outside and "
+         << m_nLeft << " leaving r < " << std::sqrt( m_radius2 ) / m << " m, |z| < " << m_halfLength / m << " m" << G4endl;
+}
@@ -0,0 +1,95 @@
+#include "TrackKillerMessenger.h"
+#include "TrackKiller.h"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4ParticleTable.hh"
+
+#include <sstream>
+
+TrackKillerMessenger::TrackKillerMessenger( TrackKiller* killer ) : G4UImessenger(), m_killer( killer )
+{
+  m_directory = new G4UIdirectory( "/kill/" );
+  m_directory->SetGuidance( "Stop tracking particles that cannot reach the trackers" );
+
+  m_neutrinosCmd = new G4UIcmdWithABool( "/kill/neutrinos", this );
+  m_neutrinosCmd->SetGuidance( "Kill neutrinos as soon as they are made (off by default)" );
+  m_neutrinosCmd->SetParameterName( "kill", true );
+  m_neutrinosCmd->SetDefaultValue( true );
+  m_neutrinosCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+
+  m_thresholdCmd = new G4UIcommand( "/kill/threshold", this );
+  m_thresholdCmd->SetGuidance( "Kill new tracks of this particle below this kinetic energy" );
+  m_thresholdCmd->SetGuidance( "e.g. /kill/threshold e- 1 MeV" );
+  m_thresholdCmd->SetParameter( new G4UIparameter( "particle", 's', false ) );
+  G4UIparameter* energyParameter = new G4UIparameter( "energy", 'd', false );
+  energyParameter->SetParameterRange( "energy >= 0" );
+  m_thresholdCmd->SetParameter( energyParameter );
+  G4UIparameter* unitParameter = new G4UIparameter( "unit", 's', true );
+  unitParameter->SetDefaultValue( "MeV" );
+  unitParameter->SetParameterCandidates( G4UIcommand::UnitsList( "Energy" ) );
+  m_thresholdCmd->SetParameter( unitParameter );
+  m_thresholdCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+
+  m_fiducialCutCmd = new G4UIcmdWithABool( "/kill/fiducialCut", this );
+  m_fiducialCutCmd->SetGuidance( "Kill tracks outside the fiducial cylinder around the trackers (off by default)" );
+  m_fiducialCutCmd->SetParameterName( "cut", true );
+  m_fiducialCutCmd->SetDefaultValue( true );
+  m_fiducialCutCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+
+  m_fiducialRadiusCmd = new G4UIcmdWithADoubleAndUnit( "/kill/fiducialRadius", this );
+  m_fiducialRadiusCmd->SetGuidance( "Radius of the fiducial cylinder, 0 for the outer tracker radius plus the margin" );
+  m_fiducialRadiusCmd->SetParameterName( "radius", false );
+  m_fiducialRadiusCmd->SetRange( "radius >= 0" );
+  m_fiducialRadiusCmd->SetUnitCategory( "Length" );
+  m_fiducialRadiusCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+
+  m_fiducialHalfLengthCmd = new G4UIcmdWithADoubleAndUnit( "/kill/fiducialHalfLength", this );
+  m_fiducialHalfLengthCmd->SetGuidance( "Half length of the fiducial cylinder, 0 for the tracker half length plus the margin" );
+  m_fiducialHalfLengthCmd->SetParameterName( "halfLength", false );
+  m_fiducialHalfLengthCmd->SetRange( "halfLength >= 0" );
+  m_fiducialHalfLengthCmd->SetUnitCategory( "Length" );
+  m_fiducialHalfLengthCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+
+  m_fiducialMarginCmd = new G4UIcmdWithADoubleAndUnit( "/kill/fiducialMargin", this );
+  m_fiducialMarginCmd->SetGuidance( "Space left around the trackers when the fiducial cylinder follows the geometry" );
+  m_fiducialMarginCmd->SetParameterName( "margin", false );
+  m_fiducialMarginCmd->SetUnitCategory( "Length" );
+  m_fiducialMarginCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+}
+
+TrackKillerMessenger::~TrackKillerMessenger()
+{
+  delete m_neutrinosCmd;
+  delete m_thresholdCmd;
+  delete m_fiducialCutCmd;
+  delete m_fiducialRadiusCmd;
+  delete m_fiducialHalfLengthCmd;
+  delete m_fiducialMarginCmd;
+  delete m_directory;
+}
+
+void TrackKillerMessenger::SetNewValue( G4UIcommand* command, G4String newValue )
+{
+  if ( command == m_neutrinosCmd ) m_killer->SetKillNeutrinos( m_neutrinosCmd->GetNewBoolValue( newValue ) );
+  else if ( command == m_thresholdCmd )
+  {
+    G4String particleName, unit;
+    G4double energy = 0.0;
+    std::istringstream( newValue ) >> particleName >> energy >> unit;
+    G4ParticleDefinition* particle = G4ParticleTable::GetParticleTable()->FindParticle( particleName );
+    if ( !particle )
+    {
+      G4cerr << "/kill/threshold: unknown particle " << particleName << G4endl;
+      return;
+    }
+    m_killer->SetThreshold( particle->GetPDGEncoding(), energy * G4UIcommand::ValueOf( unit ) );
+  }
+  else if ( command == m_fiducialCutCmd ) m_killer->SetFiducialCut( m_fiducialCutCmd->GetNewBoolValue( newValue ) );
+  else if ( command == m_fiducialRadiusCmd ) m_killer->SetFiducialRadius( m_fiducialRadiusCmd->GetNewDoubleValue( newValue ) );
+  else if ( command == m_fiducialHalfLengthCmd ) m_killer->SetFiducialHalfLength( m_fiducialHalfLengthCmd->GetNewDoubleValue( newValue ) );
+  else if ( command == m_fiducialMarginCmd ) m_killer->SetFiducialMargin( m_fiducialMarginCmd->GetNewDoubleValue( newValue ) );
+}
@@ -0,0 +1,34 @@
+#include "TrackerHit.h"
+
+#include "G4UnitsTable.hh"
+
+G4ThreadLocal G4Allocator< TrackerHit >* TrackerHitAllocator = 0;
+
+TrackerHit::TrackerHit( G4int trackID, G4int layer ) : G4VHit(), m_trackID( trackID ), m_layer( layer )
+{
+}
+
+TrackerHit::~TrackerHit()
+{
+}
+
+void TrackerHit::AddStep( G4double energy, const G4ThreeVector& position )
+{
+  ++m_nSteps;
+  m_energy += energy;
+  m_weightedPositionSum += energy * position;
+  m_positionSum += position;
+}
+
+G4ThreeVector TrackerHit::GetPosition() const
+{
+  if ( m_energy > 0.0 ) return m_weightedPositionSum / m_energy;
+  if ( m_nSteps > 0 ) return m_positionSum / m_nSteps;
+  return G4ThreeVector();
+}
+
+void TrackerHit::Print()
+{
+  G4cout << "Track " << m_trackID << " in layer " << m_layer << ": " << m_nSteps << " steps, "
+         << G4BestUnit( m_energy, "Energy" ) << " at " << G4BestUnit( this->GetPosition(), "Length" ) << G4endl;
+}
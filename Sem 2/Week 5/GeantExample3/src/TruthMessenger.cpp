@@ -0,0 +1,48 @@
+#include "TruthMessenger.h"
+#include "TruthWriter.h"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4UIcmdWithAnInteger.hh"
+
+TruthMessenger::TruthMessenger( TruthWriter* writer ) : G4UImessenger(), m_writer( writer )
+{
+  m_directory = new G4UIdirectory( "/truth/" );
+  m_directory->SetGuidance( "Choice of the generator particles written to the Truth ntuple" );
+  m_directory->SetGuidance( "The default is final-state (status 1) electrons and muons" );
+
+  m_addPdgCmd = new G4UIcmdWithAnInteger( "/truth/addPdg", this );
+  m_addPdgCmd->SetGuidance( "Also write particles with this PDG code" );
+  m_addPdgCmd->SetParameterName( "pdgCode", false );
+  m_addPdgCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+
+  m_clearPdgCmd = new G4UIcmdWithoutParameter( "/truth/clearPdg", this );
+  m_clearPdgCmd->SetGuidance( "Empty the PDG code list (an empty list selects every code)" );
+  m_clearPdgCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+
+  m_addStatusCmd = new G4UIcmdWithAnInteger( "/truth/addStatus", this );
+  m_addStatusCmd->SetGuidance( "Also write particles with this generator status" );
+  m_addStatusCmd->SetParameterName( "status", false );
+  m_addStatusCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+
+  m_clearStatusCmd = new G4UIcmdWithoutParameter( "/truth/clearStatus", this );
+  m_clearStatusCmd->SetGuidance( "Empty the status list (an empty list selects every status)" );
+  m_clearStatusCmd->AvailableForStates( G4State_PreInit, G4State_Idle );
+}
+
+TruthMessenger::~TruthMessenger()
+{
+  delete m_addPdgCmd;
+  delete m_clearPdgCmd;
+  delete m_addStatusCmd;
+  delete m_clearStatusCmd;
+  delete m_directory;
+}
+
+void TruthMessenger::SetNewValue( G4UIcommand* command, G4String newValue )
+{
+  if ( command == m_addPdgCmd ) m_writer->AddPdg( m_addPdgCmd->GetNewIntValue( newValue ) );
+  else if ( command == m_clearPdgCmd ) m_writer->ClearPdg();
+  else if ( command == m_addStatusCmd ) m_writer->AddStatus( m_addStatusCmd->GetNewIntValue( newValue ) );
+  else if ( command == m_clearStatusCmd ) m_writer->ClearStatus();
+}
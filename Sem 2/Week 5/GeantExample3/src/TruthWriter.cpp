@@ -0,0 +1,83 @@
+#include "TruthWriter.h"
+#include "TruthMessenger.h"
+
+#include "Output.h"
+#include "G4SystemOfUnits.hh"
+
+TruthWriter::TruthWriter()
+{
+  // Default: final-state electrons and muons
+  for ( G4int pdgCode : { 11, -11, 13, -13 } ) m_pdgCodes.insert( pdgCode );
+  m_statuses.insert( 1 );
+
+  m_messenger = new TruthMessenger( this );
+}
+
+TruthWriter::~TruthWriter()
+{
+  delete m_messenger;
+}
+
+void TruthWriter::Book()
+{
+  auto analysisManager = Output::GetAnalysisManager();
+
+  // Add an ntuple for truth, one row per event
+  m_ntupleID = analysisManager->CreateNtuple( "Truth", "Truth information" );
+  analysisManager->CreateNtupleIColumn( "EventNumber" );
+  analysisManager->CreateNtupleIColumn( "Barcode", m_barcode );
+  analysisManager->CreateNtupleIColumn( "PdgCode", m_pdgCode );
+  analysisManager->CreateNtupleIColumn( "Status", m_status );
+  analysisManager->CreateNtupleDColumn( "Phi", m_phi );
+  analysisManager->CreateNtupleDColumn( "Theta", m_theta );
+  analysisManager->CreateNtupleDColumn( "Momentum", m_momentum ); // GeV
+  analysisManager->CreateNtupleDColumn( "VertexX", m_vertexX );   // mm
+  analysisManager->CreateNtupleDColumn( "VertexY", m_vertexY );
+  analysisManager->CreateNtupleDColumn( "VertexZ", m_vertexZ );
+  analysisManager->FinishNtuple();
+}
+
+void TruthWriter::Clear()
+{
+  m_barcode.clear();
+  m_pdgCode.clear();
+  m_status.clear();
+  m_phi.clear();
+  m_theta.clear();
+  m_momentum.clear();
+  m_vertexX.clear();
+  m_vertexY.clear();
+  m_vertexZ.clear();
+}
+
+void TruthWriter::Collect( const PrimaryEvent& event )
+{
+  this->Clear();
+  m_eventNumber = event.eventNumber;
+  for ( const TruthParticleData& particle : event.truth )
+  {
+    if ( !m_pdgCodes.empty() && !m_pdgCodes.count( particle.pdgCode ) ) continue;
+    if ( !m_statuses.empty() && !m_statuses.count( particle.status ) ) continue;
+
+    m_barcode.push_back( particle.barcode );
+    m_pdgCode.push_back( particle.pdgCode );
+    m_status.push_back( particle.status );
+    m_phi.push_back( particle.momentum.phi() );
+    m_theta.push_back( particle.momentum.theta() );
+    // Divide by the unit when outputting
+    m_momentum.push_back( particle.momentum.mag() / GeV );
+    m_vertexX.push_back( particle.vertex.x() / mm );
+    m_vertexY.push_back( particle.vertex.y() / mm );
+    m_vertexZ.push_back( particle.vertex.z() / mm );
+  }
+}
+
+void TruthWriter::Write()
+{
+  if ( m_barcode.empty() || m_ntupleID < 0 ) return;
+
+  auto analysisManager = Output::GetAnalysisManager();
+  analysisManager->FillNtupleIColumn( m_ntupleID, 0, m_eventNumber );
+  analysisManager->AddNtupleRow( m_ntupleID );
+  this->Clear();
+}
@@ -1,17 +1,47 @@
 #include "DetectorConstruction.h"
 #include "ActionInitialization.h"
+#include "HepMCEventSource.h"
+#include "Output.h"
 
+#ifdef G4MULTITHREADED
+#include "G4MTRunManager.hh"
+#else
 #include "G4RunManager.hh"
+#endif
 #include "G4UImanager.hh"
 #include "FTFP_BERT.hh"
 #include "G4StepLimiterPhysics.hh"
 #include "Randomize.hh"
 #include "G4VisExecutive.hh"
 #include "G4UIExecutive.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <cstdlib>
 
 
 int main( int argc, char* argv[] )
 {
+  // Options on the command line
+  // -t N: number of worker threads, default all cores
+  // -o csv|root|xml|hdf5: output format, default csv (hdf5 needs Geant4 built with HDF5)
+  // -z N: compression level of the output (ROOT and HDF5), default 1
+  G4int nThreads = 0;
+  for ( G4int i = 1; i < argc - 1; ++i )
+  {
+    G4String option = argv[i];
+    if ( option == "-t" ) nThreads = std::atoi( argv[i+1] );
+    else if ( option == "-o" && !Output::SetFormat( argv[i+1] ) )
+    {
+      G4cerr << "Unknown output format " << argv[i+1] << ", use csv, root or xml";
+#ifdef WITH_HDF5
+      G4cerr << " or hdf5";
+#endif
+      G4cerr << G4endl;
+      return 1;
+    }
+    else if ( option == "-z" ) Output::SetCompressionLevel( std::atoi( argv[i+1] ) );
+  }
+
   // Start interactive session using the command line arguments
   G4UIExecutive* ui = new G4UIExecutive( argc, argv );
 
@@ -19,8 +49,14 @@ int main( int argc, char* argv[] )
   G4Random::setTheEngine( new CLHEP::RanecuEngine );
   G4Random::setTheSeed( 1234 );
 
-  // Construct the default run manager
+  // Construct the run manager, with one worker per thread if Geant4 allows it
+#ifdef G4MULTITHREADED
+  G4MTRunManager* runManager = new G4MTRunManager();
+  if ( nThreads <= 0 ) nThreads = G4Threading::G4GetNumberOfCores();
+  runManager->SetNumberOfThreads( nThreads );
+#else
   G4RunManager* runManager = new G4RunManager();
+#endif
 
   // Set up detector
   runManager->SetUserInitialization( new DetectorConstruction() );
@@ -28,8 +64,13 @@ int main( int argc, char* argv[] )
   // Set up physics processes
   G4VModularPhysicsList* physicsList = new FTFP_BERT();
   physicsList->RegisterPhysics( new G4StepLimiterPhysics() );
+  // Coarse cuts outside the detector regions, which set their own in DetectorConstruction
+  physicsList->SetDefaultCutValue( 1.0*m );
   runManager->SetUserInitialization( physicsList );
 
+  // Create the shared HepMC input here, so its /hepmc/ commands exist on the master
+  HepMCEventSource::Instance();
+
   // Set user action classes (just the generator really)
   runManager->SetUserInitialization( new ActionInitialization() );
 